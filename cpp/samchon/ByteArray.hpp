@@ -2,6 +2,12 @@
 
 #include <vector>
 #include <string>
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <samchon/ByteArrayAllocator.hpp>
 
 namespace samchon
 {
@@ -11,7 +17,15 @@ namespace samchon
 	 * @details
 	 * <p> ByteArray is the standard class for handling binary data in Samchon Framework. </p>
 	 * <p> ByteArray provides methods for reading and writing binary data. </p>
-	 * <p> In addition, zlib compression and decompression are supported. </p>
+	 * <p> In addition, zlib compression and decompression are supported, by including ByteArrayCompression.hpp. </p>
+	 * <p> Memory of a ByteArray is allocated by the ByteArrayAllocator; large blocks are recycled from a pool. Bytes
+	 * added by resize() are zero-filled, but those added by resizeUninitialized() are not. </p>
+	 * 
+	 * @warning
+	 * <p> For the allocator, base of the ByteArray is std::vector<unsigned char, ByteArrayAllocator<unsigned char>>,
+	 * not std::vector<unsigned char> as before. A ByteArray can't be bound to a reference of std::vector<unsigned char>
+	 * any more. Convert them by toVector() and the constructor from std::vector<unsigned char>, which copy the
+	 * bytes. </p>
 	 * 
 	 * @note
 	 * <p> ByteArray is a class only for advanced developer who can access data on byte level as the reason of: </p>
@@ -27,10 +41,10 @@ namespace samchon
 	 * @author Jeongho Nam <http://samchon.org>
 	 */
 	class ByteArray
-		: public std::vector<unsigned char>
+		: public std::vector<unsigned char, ByteArrayAllocator<unsigned char>>
 	{
 	private:
-		typedef std::vector<unsigned char> super;
+		typedef std::vector<unsigned char, ByteArrayAllocator<unsigned char>> super;
 
 		/**
 		 * @brief Current position of the ByteArray.\n
@@ -71,6 +85,16 @@ namespace samchon
 			position = 0;
 		};
 
+		/**
+		 * @brief Construct from a std::vector
+		 *
+		 * @details Copies bytes of a std::vector<unsigned char>, which has the default allocator.
+		 */
+		ByteArray(const std::vector<unsigned char> &obj) : super(obj.begin(), obj.end())
+		{
+			position = 0;
+		};
+
 		auto operator=(const ByteArray &obj) -> ByteArray&
 		{
 			assign(obj.begin(), obj.end());
@@ -87,6 +111,16 @@ namespace samchon
 			return *this;
 		};
 
+		/**
+		 * @brief Copy to a std::vector
+		 *
+		 * @details Copies the bytes to a std::vector<unsigned char>, which has the default allocator.
+		 */
+		auto toVector() const -> std::vector<unsigned char>
+		{
+			return std::vector<unsigned char>(begin(), end());
+		};
+
 		/* --------------------------------------------------------------
 			POSITION
 		-------------------------------------------------------------- */
@@ -136,6 +170,50 @@ namespace samchon
 			return res;
 		};
 
+		/* --------------------------------------------------------------
+			SIZE
+		-------------------------------------------------------------- */
+		/**
+		 * @brief Resize the ByteArray
+		 *
+		 * @details Bytes added are zero-filled, as std::vector does.
+		 *
+		 * @param size New size in bytes.
+		 */
+		void resize(size_t size)
+		{
+			size_t old_size = this->size();
+			super::resize(size);
+
+			if (size > old_size)
+				std::memset(data() + old_size, 0, size - old_size);
+		};
+
+		/**
+		 * @brief Resize the ByteArray, filling added bytes
+		 *
+		 * @param size New size in bytes.
+		 * @param val A byte to fill the added bytes.
+		 */
+		void resize(size_t size, unsigned char val)
+		{
+			super::resize(size, val);
+		};
+
+		/**
+		 * @brief Resize the ByteArray without zero-fill
+		 *
+		 * @details
+		 * <p> Bytes added are left indeterminate. It saves the zero-fill for a buffer which is to be overwritten at 
+		 * once, like a destination of a socket read or decompression. </p>
+		 *
+		 * @param size New size in bytes.
+		 */
+		void resizeUninitialized(size_t size)
+		{
+			super::resize(size);
+		};
+
 		/* --------------------------------------------------------------
 			READ BYTES
 		-------------------------------------------------------------- */
@@ -234,12 +312,13 @@ namespace samchon
 		 * <p> Generates a binary data compressed from the ByteArray. </p>
 		 * <p> The binary data will be compressed by zlib library. </p>
 		 * 
+		 * @note Defined in ByteArrayCompression.hpp, which includes zlib. Include it to compress.
+		 * 
+		 * @param level Compression level of zlib, from 1 (best speed) to 9 (best compression). Default is -1, 
+		 *				Z_DEFAULT_COMPRESSION.
 		 * @return ByteArray which is compressed
 		 */
-		auto compress() const -> ByteArray
-		{
-			return{};
-		};
+		inline auto compress(int level = -1) const -> ByteArray;
 
 		/**
 		 * @brief Decompress the binary data
@@ -248,11 +327,46 @@ namespace samchon
 		 * <p> Generates a decompressed binary data form the ByteArray. </p>
 		 * <p> The binary data will be decompressed by zlib library. </p>
 		 * 
+		 * @note Defined in ByteArrayCompression.hpp, which includes zlib. Include it to decompress.
+		 * 
+		 * @param max_size Maximum size of the decompressed data.
 		 * @return ByteArray that is decompressed
+		 * @throw domain_error If the ByteArray is not a valid zlib stream.
+		 * @throw length_error If the decompressed data exceeds the *max_size*.
 		 */
-		auto decompress() const -> ByteArray
-		{
-			return{};
-		};
+		inline auto decompress(size_t max_size = SIZE_MAX) const -> ByteArray;
+
+		/**
+		 * @brief Compress a binary data
+		 *
+		 * @note Defined in ByteArrayCompression.hpp, which includes zlib. Include it to compress.
+		 *
+		 * @param data Address of the binary data.
+		 * @param size Size of the binary data.
+		 * @param level Compression level of zlib, from 1 (best speed) to 9 (best compression). Default is -1, 
+		 *				Z_DEFAULT_COMPRESSION.
+		 *
+		 * @return ByteArray which is compressed
+		 */
+		static inline auto compress(const unsigned char *data, size_t size, int level = -1) -> ByteArray;
+
+		/**
+		 * @brief Decompress a binary data
+		 *
+		 * @details
+		 * <p> Decompressing data from a remote system, limit the *max_size*; a small zlib stream can be inflated to 
+		 * gigabytes. Decompression stops as soon as the limit is exceeded. </p>
+		 *
+		 * @note Defined in ByteArrayCompression.hpp, which includes zlib. Include it to decompress.
+		 *
+		 * @param data Address of the binary data, a zlib stream.
+		 * @param size Size of the binary data.
+		 * @param max_size Maximum size of the decompressed data.
+		 *
+		 * @return ByteArray that is decompressed
+		 * @throw domain_error If the binary data is not a valid zlib stream.
+		 * @throw length_error If the decompressed data exceeds the *max_size*.
+		 */
+		static inline auto decompress(const unsigned char *data, size_t size, size_t max_size = SIZE_MAX) -> ByteArray;
 	};
 };
\ No newline at end of file
@@ -0,0 +1,264 @@
+#pragma once
+#include <samchon/API.hpp>
+
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace samchon
+{
+	/**
+	 * @brief A pool of memory blocks for ByteArray
+	 *
+	 * @details
+	 * <p> ByteArrayPool recycles large memory blocks of ByteArray objects by size classes, which are powers of two
+	 * from 4 KB to 64 MB. When a ByteArray is destroyed, its block goes back to the pool, and the next ByteArray of a
+	 * similar size takes it without calling the system allocator. It reduces memory churn and allocator contention
+	 * when large binary data, like parameters of {@link protocol::Invoke} messages, are received repeatedly. </p>
+	 *
+	 * <p> Blocks smaller than 4 KB or larger than 64 MB are not pooled. Cached blocks of all the size classes are bounded
+	 * by a {@link setCapacity capacity}, 64 MB by default; blocks over it go back to the system. After a burst, call
+	 * {@link trim trim()} to release the cached blocks. </p>
+	 *
+	 * @see samchon::ByteArray
+	 * @author Jeongho Nam <http://samchon.org>
+	 */
+	class ByteArrayPool
+	{
+	private:
+		enum : size_t
+		{
+			MIN_SIZE = 4 * 1024,
+			NUM_CLASSES = 15
+		};
+
+		struct SizeClass
+		{
+			std::mutex mtx;
+			std::vector<void*> blocks;
+		};
+		std::array<SizeClass, NUM_CLASSES> classes;
+
+		// BYTES OF THE CACHED BLOCKS
+		std::atomic<size_t> cached;
+		std::atomic<size_t> capacity;
+
+	public:
+		/**
+		 * @brief Get the pool
+		 *
+		 * @details The pool is never destructed, so that ByteArray objects destructed later can return their blocks.
+		 */
+		static auto get() -> ByteArrayPool&
+		{
+			static ByteArrayPool *singleton = new ByteArrayPool();
+			return *singleton;
+		};
+
+		/**
+		 * @brief Allocate a memory block
+		 *
+		 * @param size Size of the block in bytes.
+		 */
+		auto allocate(size_t size) -> void*
+		{
+			size_t index = class_of(size);
+			if (index == NUM_CLASSES)
+				return ::operator new(size);
+
+			SizeClass &size_class = classes[index];
+			{
+				std::unique_lock<std::mutex> uk(size_class.mtx);
+				if (size_class.blocks.empty() == false)
+				{
+					void *block = size_class.blocks.back();
+					size_class.blocks.pop_back();
+					cached -= MIN_SIZE << index;
+
+					return block;
+				}
+			}
+			return ::operator new(MIN_SIZE << index);
+		};
+
+		/**
+		 * @brief Deallocate a memory block
+		 *
+		 * @param block Address of the block.
+		 * @param size Size of the block in bytes, same with the one requested to allocate.
+		 */
+		void deallocate(void *block, size_t size)
+		{
+			size_t index = class_of(size);
+			if (index != NUM_CLASSES)
+			{
+				// RESERVE ROOM IN THE CAPACITY FIRST
+				size_t block_size = MIN_SIZE << index;
+				if (cached.fetch_add(block_size) + block_size <= capacity)
+				{
+					SizeClass &size_class = classes[index];
+					std::unique_lock<std::mutex> uk(size_class.mtx);
+
+					size_class.blocks.push_back(block);
+					return;
+				}
+				cached -= block_size;
+			}
+			::operator delete(block);
+		};
+
+		/* --------------------------------------------------------------
+			CAPACITY
+		-------------------------------------------------------------- */
+		/**
+		 * @brief Set capacity of the pool
+		 *
+		 * @details Bounds bytes of the blocks cached over all the size classes. Blocks already cached over the new 
+		 * capacity are released.
+		 *
+		 * @param bytes Maximum bytes to cache, zero not to pool at all. Default is 64 MB.
+		 */
+		void setCapacity(size_t bytes)
+		{
+			capacity = bytes;
+			trim(bytes);
+		};
+
+		/**
+		 * @brief Get capacity of the pool
+		 */
+		auto getCapacity() const -> size_t
+		{
+			return capacity;
+		};
+
+		/**
+		 * @brief Get bytes of the cached blocks
+		 */
+		auto size() const -> size_t
+		{
+			return cached;
+		};
+
+		/**
+		 * @brief Release cached blocks
+		 *
+		 * @details Gives cached blocks back to the system, the largest ones first, until the cached bytes are equal or 
+		 * less than the *bytes*. The blocks in use are not affected.
+		 *
+		 * @param bytes Bytes to keep cached. Default is zero; releases all.
+		 */
+		void trim(size_t bytes = 0)
+		{
+			for (size_t index = NUM_CLASSES; index-- > 0 && cached > bytes;)
+			{
+				SizeClass &size_class = classes[index];
+				std::vector<void*> released;
+				{
+					std::unique_lock<std::mutex> uk(size_class.mtx);
+
+					while (size_class.blocks.empty() == false && cached > bytes)
+					{
+						released.push_back(size_class.blocks.back());
+						size_class.blocks.pop_back();
+						cached -= MIN_SIZE << index;
+					}
+				}
+
+				// OUT OF THE LOCK
+				for (auto it = released.begin(); it != released.end(); it++)
+					::operator delete(*it);
+			}
+		};
+
+	private:
+		ByteArrayPool()
+		{
+			cached = 0;
+			capacity = 64 * 1024 * 1024;
+		};
+		ByteArrayPool(const ByteArrayPool &) = delete;
+
+		static auto class_of(size_t size) -> size_t
+		{
+			if (size < MIN_SIZE)
+				return NUM_CLASSES;
+
+			size_t index = 0;
+			while ((MIN_SIZE << index) < size)
+				if (++index == NUM_CLASSES)
+					break;
+
+			return index;
+		};
+	};
+
+	/**
+	 * @brief Allocator of ByteArray
+	 *
+	 * @details
+	 * <p> ByteArrayAllocator takes memory blocks from the ByteArrayPool. In addition, it default-initializes elements
+	 * instead of zero-filling them, so that ByteArray::resizeUninitialized() can leave new bytes indeterminate for a 
+	 * buffer to be overwritten by a socket read. ByteArray::resize() zero-fills them by itself. </p>
+	 *
+	 * @see samchon::ByteArray
+	 * @author Jeongho Nam <http://samchon.org>
+	 */
+	template <typename T>
+	class ByteArrayAllocator
+	{
+	public:
+		typedef T value_type;
+
+		template <typename U>
+		struct rebind
+		{
+			typedef ByteArrayAllocator<U> other;
+		};
+
+		ByteArrayAllocator() = default;
+
+		template <typename U>
+		ByteArrayAllocator(const ByteArrayAllocator<U> &)
+		{
+		};
+
+		auto allocate(size_t n) -> T*
+		{
+			return (T*)ByteArrayPool::get().allocate(n * sizeof(T));
+		};
+
+		void deallocate(T *ptr, size_t n)
+		{
+			ByteArrayPool::get().deallocate(ptr, n * sizeof(T));
+		};
+
+		template <typename U>
+		void construct(U *ptr)
+		{
+			// DEFAULT-INITIALIZATION, WITHOUT ZERO-FILL
+			::new ((void*)ptr) U;
+		};
+
+		template <typename U, typename... Args>
+		void construct(U *ptr, Args&&... args)
+		{
+			::new ((void*)ptr) U(std::forward<Args>(args)...);
+		};
+
+		template <typename U>
+		auto operator==(const ByteArrayAllocator<U> &) const -> bool
+		{
+			return true;
+		};
+
+		template <typename U>
+		auto operator!=(const ByteArrayAllocator<U> &) const -> bool
+		{
+			return false;
+		};
+	};
+};
@@ -0,0 +1,127 @@
+#pragma once
+#include <samchon/ByteArray.hpp>
+
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <stdexcept>
+#include <zlib.h>
+
+namespace samchon
+{
+	/* --------------------------------------------------------------
+		COMPRESS & DECOMPRESS OF BYTE_ARRAY, WHICH REQUIRE ZLIB
+	-------------------------------------------------------------- */
+	inline auto ByteArray::compress(int level) const -> ByteArray
+	{
+		return compress(data(), size(), level);
+	};
+
+	inline auto ByteArray::decompress(size_t max_size) const -> ByteArray
+	{
+		return decompress(data(), size(), max_size);
+	};
+
+	inline auto ByteArray::compress(const unsigned char *data, size_t size, int level) -> ByteArray
+	{
+		z_stream stream = {};
+		if (deflateInit(&stream, level) != Z_OK)
+			throw std::invalid_argument("invalid compression level.");
+
+		ByteArray ret;
+		ret.resizeUninitialized(std::max<size_t>(size / 2, 64));
+
+		size_t written = 0;
+		int result = Z_BUF_ERROR;
+
+		do
+		{
+			// FEED INPUT BY CHUNKS OF UINT
+			if (stream.avail_in == 0 && size != 0)
+			{
+				size_t piece = std::min<size_t>(size, UINT_MAX);
+
+				stream.next_in = (Bytef*)data;
+				stream.avail_in = (uInt)piece;
+				data += piece;
+				size -= piece;
+			}
+
+			// EXTEND OUTPUT
+			if (written == ret.size())
+				ret.resizeUninitialized(ret.size() * 2);
+
+			stream.next_out = ret.data() + written;
+			stream.avail_out = (uInt)std::min<size_t>(ret.size() - written, UINT_MAX);
+
+			uInt capacity = stream.avail_out;
+			result = deflate(&stream, (size == 0) ? Z_FINISH : Z_NO_FLUSH);
+			written += capacity - stream.avail_out;
+		}
+		while (result == Z_OK || result == Z_BUF_ERROR);
+
+		deflateEnd(&stream);
+		if (result != Z_STREAM_END)
+			throw std::runtime_error("failed to compress.");
+
+		ret.resize(written);
+		return ret;
+	};
+
+	inline auto ByteArray::decompress(const unsigned char *data, size_t size, size_t max_size) -> ByteArray
+	{
+		z_stream stream = {};
+		if (inflateInit(&stream) != Z_OK)
+			throw std::runtime_error("failed to initialize zlib.");
+
+		// A BYTE OVER THE MAX_SIZE TELLS IT'S BEEN EXCEEDED
+		size_t limit = (max_size == SIZE_MAX) ? SIZE_MAX : max_size + 1;
+
+		ByteArray ret;
+		ret.resizeUninitialized(std::min<size_t>(std::max<size_t>(size * 4, 64), limit));
+
+		size_t written = 0;
+		int result = Z_BUF_ERROR;
+
+		do
+		{
+			// FEED INPUT BY CHUNKS OF UINT
+			if (stream.avail_in == 0 && size != 0)
+			{
+				size_t piece = std::min<size_t>(size, UINT_MAX);
+
+				stream.next_in = (Bytef*)data;
+				stream.avail_in = (uInt)piece;
+				data += piece;
+				size -= piece;
+			}
+			else if (stream.avail_in == 0 && written != ret.size())
+				break; // TRUNCATED
+
+			// EXTEND OUTPUT, UNTIL THE LIMIT
+			if (written == ret.size())
+				ret.resizeUninitialized((ret.size() > limit / 2) ? limit : ret.size() * 2);
+
+			stream.next_out = ret.data() + written;
+			stream.avail_out = (uInt)std::min<size_t>(ret.size() - written, UINT_MAX);
+
+			uInt capacity = stream.avail_out;
+			result = inflate(&stream, Z_NO_FLUSH);
+			written += capacity - stream.avail_out;
+
+			if (written > max_size)
+			{
+				inflateEnd(&stream);
+				throw std::length_error("decompressed data exceeds the maximum size.");
+			}
+		}
+		while (result == Z_OK || result == Z_BUF_ERROR);
+
+		inflateEnd(&stream);
+		if (result != Z_STREAM_END)
+			throw std::domain_error("invalid zlib stream to decompress.");
+
+		ret.resize(written);
+		return ret;
+	};
+};
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include <samchon/protocol/Server.hpp>
+
+namespace samchon
+{
+namespace examples
+{
+namespace benchmark
+{
+namespace accept
+{
+	class CountingServer
+		: public protocol::Server
+	{
+	public:
+		std::atomic<size_t> accepted;
+
+		CountingServer()
+		{
+			accepted = 0;
+		};
+
+	protected:
+		virtual void addClient(std::shared_ptr<protocol::ClientDriver>) override
+		{
+			// THE DRIVER IS DISCARDED, ONLY ACCEPTANCE IS MEASURED
+			accepted++;
+		};
+	};
+
+	/**
+	 * Measure connections accepted per second.
+	 *
+	 * Clients of *threads* connect *connections* times in total, as a storm of reconnections, to a server opened in the
+	 * asynchronous mode with 1 acceptor and then with *acceptors* acceptors.
+	 */
+	void measure(size_t acceptors, size_t connections, size_t threads, int port)
+	{
+		using namespace std;
+		using namespace samchon::protocol;
+
+		shared_ptr<IOServicePool> pool(new IOServicePool());
+
+		SocketOptions options;
+		options.backlog = 4096;
+
+		CountingServer server;
+		server.setIOServicePool(pool);
+		server.setSocketOptions(options);
+		server.setAcceptors(acceptors);
+		server.open(port);
+
+		boost::asio::ip::tcp::endpoint endpoint(boost::asio::ip::address::from_string("127.0.0.1"), port);
+		atomic<size_t> failed(0);
+
+		auto first = chrono::steady_clock::now();
+		vector<thread> clients;
+
+		for (size_t i = 0; i < threads; i++)
+			clients.emplace_back([&, i]()
+			{
+				boost::asio::io_service service;
+				for (size_t j = i; j < connections; j += threads)
+				{
+					boost::asio::ip::tcp::socket socket(service);
+					boost::system::error_code error;
+
+					socket.connect(endpoint, error);
+					if (error)
+						failed++;
+				}
+			});
+		for (auto it = clients.begin(); it != clients.end(); it++)
+			it->join();
+
+		// WAIT FOR THE ACCEPT QUEUE TO BE DRAINED
+		while (server.accepted + failed < connections && chrono::steady_clock::now() - first < chrono::seconds(30))
+			this_thread::sleep_for(chrono::milliseconds(1));
+
+		double seconds = chrono::duration<double>(chrono::steady_clock::now() - first).count();
+		server.close();
+
+		cout << "acceptors: " << server.getAcceptors()
+			<< ", accepted: " << server.accepted << "/" << connections
+			<< ", failed: " << failed
+			<< ", elapsed: " << seconds * 1000.0 << " ms"
+			<< ", rate: " << (size_t)(server.accepted / seconds) << " conn/s" << endl;
+	};
+
+	void main(size_t acceptors = std::thread::hardware_concurrency(), size_t connections = 10000, size_t threads = 16, int port = 20400)
+	{
+		measure(1, connections, threads, port);
+		measure(acceptors, connections, threads, port + 1);
+	};
+};
+};
+};
+};
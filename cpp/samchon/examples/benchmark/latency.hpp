@@ -0,0 +1,278 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <samchon/library/Histogram.hpp>
+#include <samchon/protocol/Server.hpp>
+#include <samchon/protocol/ServerConnector.hpp>
+#include <samchon/protocol/WebServer.hpp>
+#include <samchon/protocol/WebServerConnector.hpp>
+
+namespace samchon
+{
+namespace examples
+{
+namespace benchmark
+{
+namespace latency
+{
+	/**
+	 * A case to measure.
+	 */
+	struct Scenario
+	{
+		/**
+		 * Bytes of parameters in a message, except the timestamp.
+		 */
+		size_t payload;
+
+		/**
+		 * Number of parameters sharing the *payload*.
+		 */
+		size_t parameters;
+
+		/**
+		 * Whether the parameters are binary attachments, {@link ByteArray} objects, instead of strings.
+		 */
+		bool binary;
+	};
+
+	class Echo
+		: public protocol::IProtocol
+	{
+	public:
+		std::shared_ptr<protocol::ClientDriver> driver;
+
+		virtual void replyData(std::shared_ptr<protocol::Invoke> invoke) override
+		{
+			driver->sendData(invoke);
+		};
+		virtual void sendData(std::shared_ptr<protocol::Invoke> invoke) override
+		{
+			driver->sendData(invoke);
+		};
+	};
+
+	template <class Base>
+	class EchoServer
+		: public Base
+	{
+	private:
+		std::mutex mutex;
+		std::vector<std::shared_ptr<Echo>> echos;
+
+	protected:
+		virtual void addClient(std::shared_ptr<protocol::ClientDriver> driver) override
+		{
+			std::shared_ptr<Echo> echo(new Echo());
+			echo->driver = driver;
+			{
+				std::unique_lock<std::mutex> uk(mutex);
+				echos.push_back(echo);
+			}
+			driver->listen(echo.get());
+		};
+	};
+
+	/**
+	 * A synthetic client.
+	 *
+	 * The {@link Client} keeps *depth* messages in flight, sending a next message whenever an echo arrives, until it
+	 * has sent *messages* messages. The first parameter of a message is the time it has been sent at, from which the
+	 * latency of its echo is recorded.
+	 */
+	template <class Connector>
+	class Client
+		: public protocol::IProtocol
+	{
+	private:
+		std::shared_ptr<Connector> connector;
+
+		const Scenario &scenario;
+		size_t messages;
+		std::atomic<size_t> sent;
+
+		library::Histogram &histogram;
+		std::atomic<size_t> &received;
+
+	public:
+		Client(const Scenario &scenario, size_t messages, library::Histogram &histogram, std::atomic<size_t> &received)
+			: connector(new Connector(this)),
+			scenario(scenario),
+			messages(messages),
+			histogram(histogram),
+			received(received)
+		{
+			sent = 0;
+		};
+
+		void connect(std::shared_ptr<protocol::IOServicePool> pool, int port)
+		{
+			connector->setIOServicePool(pool);
+			connector->connect("127.0.0.1", port);
+		};
+
+		void start(size_t depth)
+		{
+			for (size_t i = 0; i < depth; i++)
+				send();
+		};
+
+		void close()
+		{
+			connector->close();
+		};
+
+		virtual void replyData(std::shared_ptr<protocol::Invoke> invoke) override
+		{
+			long long sent_at = invoke->front()->getValue<long long>();
+			histogram.record(now() - sent_at);
+			received++;
+
+			send();
+		};
+		virtual void sendData(std::shared_ptr<protocol::Invoke>) override
+		{
+		};
+
+	private:
+		void send()
+		{
+			if (sent++ >= messages)
+				return;
+
+			std::shared_ptr<protocol::Invoke> invoke(new protocol::Invoke("echo"));
+			invoke->emplace_back(new protocol::InvokeParameter("sent_at", now()));
+
+			for (size_t i = 0; i < scenario.parameters; i++)
+			{
+				size_t size = scenario.payload / scenario.parameters + ((i < scenario.payload % scenario.parameters) ? 1 : 0);
+				if (scenario.binary == true)
+				{
+					ByteArray data;
+					data.assign(size, 'x');
+					invoke->emplace_back(new protocol::InvokeParameter("", std::move(data)));
+				}
+				else
+					invoke->emplace_back(new protocol::InvokeParameter("", std::string(size, 'x')));
+			}
+			connector->sendData(invoke);
+		};
+
+		static auto now() -> long long
+		{
+			return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+		};
+	};
+
+	/**
+	 * Measure throughput and latency of a *scenario*.
+	 *
+	 * A server of the *Base* type and *clients* clients of the *Connector* type share an {@link protocol::IOServicePool}
+	 * of a thread; an event loop. Each client keeps *depth* messages in flight until it has sent *messages* messages,
+	 * and the server echoes them back.
+	 *
+	 * @return An {@link XML} of the *scenario*, throughput and a {@link library::Histogram} of latencies in nanoseconds.
+	 */
+	template <class Base, class Connector>
+	auto measure(const std::string &transport, const Scenario &scenario, size_t clients, size_t depth, size_t messages, int port) -> std::shared_ptr<library::XML>
+	{
+		using namespace std;
+		using namespace samchon::library;
+		using namespace samchon::protocol;
+
+		shared_ptr<IOServicePool> pool(new IOServicePool(1));
+
+		EchoServer<Base> server;
+		server.setIOServicePool(pool);
+		server.open(port);
+
+		Histogram histogram;
+		atomic<size_t> received(0);
+
+		vector<shared_ptr<Client<Connector>>> connectors;
+		for (size_t i = 0; i < clients; i++)
+		{
+			shared_ptr<Client<Connector>> client(new Client<Connector>(scenario, messages, histogram, received));
+			client->connect(pool, port);
+
+			connectors.push_back(client);
+		}
+
+		auto first = chrono::steady_clock::now();
+		for (auto it = connectors.begin(); it != connectors.end(); it++)
+			(*it)->start(depth);
+
+		size_t total = clients * messages;
+		while (received < total && chrono::steady_clock::now() - first < chrono::seconds(60))
+			this_thread::sleep_for(chrono::microseconds(100));
+
+		double seconds = chrono::duration<double>(chrono::steady_clock::now() - first).count();
+
+		for (auto it = connectors.begin(); it != connectors.end(); it++)
+			(*it)->close();
+		server.close();
+		pool->stop();
+
+		shared_ptr<XML> xml(new XML());
+		xml->setTag("benchmark");
+		xml->setProperty("transport", transport);
+		xml->setProperty("payload", scenario.payload);
+		xml->setProperty("parameters", scenario.parameters);
+		xml->setProperty("binary", scenario.binary);
+		xml->setProperty("clients", clients);
+		xml->setProperty("depth", depth);
+		xml->setProperty("messages", total);
+		xml->setProperty("received", (size_t)received);
+		xml->setProperty("elapsed", seconds);
+		xml->setProperty("throughput", received / seconds);
+
+		shared_ptr<XML> latency = histogram.toXML("latency");
+		latency->setProperty("unit", "ns");
+		xml->push_back(latency);
+
+		return xml;
+	};
+
+	/**
+	 * Measure Invokes per second and their latencies.
+	 *
+	 * Pairs of {@link protocol::Server} and {@link protocol::ServerConnector}, and of {@link protocol::WebServer} and
+	 * {@link protocol::WebServerConnector} are measured, varying the payload size, the parameter count and whether
+	 * the parameters are binary attachments. The result is printed as an {@link XML}, to be compared with the result of
+	 * a former revision.
+	 */
+	void main(size_t clients = 16, size_t depth = 8, size_t messages = 10000, int port = 20600)
+	{
+		using namespace std;
+		using namespace samchon::library;
+		using namespace samchon::protocol;
+
+		vector<Scenario> scenarios;
+		for (size_t payload : { 16, 1024, 64 * 1024 })
+			for (size_t parameters : { 1, 8 })
+				for (bool binary : { false, true })
+					scenarios.push_back({ payload, parameters, binary });
+
+		shared_ptr<XML> xml(new XML());
+		xml->setTag("benchmarks");
+
+		for (auto it = scenarios.begin(); it != scenarios.end(); it++)
+		{
+			// FEWER MESSAGES OF LARGE PAYLOAD
+			size_t count = max<size_t>(messages * 1024 / max<size_t>(it->payload, 1024), 1);
+
+			xml->push_back(measure<Server, ServerConnector>("tcp", *it, clients, depth, count, port++));
+			xml->push_back(measure<WebServer, WebServerConnector>("web", *it, clients, depth, count, port++));
+		}
+		cout << xml->toString() << endl;
+	};
+};
+};
+};
+};
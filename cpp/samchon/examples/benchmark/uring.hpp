@@ -0,0 +1,167 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <samchon/protocol/Server.hpp>
+#include <samchon/protocol/ServerConnector.hpp>
+
+#include <sys/resource.h>
+
+namespace samchon
+{
+namespace examples
+{
+namespace benchmark
+{
+namespace uring
+{
+	class Echo
+		: public protocol::IProtocol
+	{
+	public:
+		std::shared_ptr<protocol::ClientDriver> driver;
+
+		virtual void replyData(std::shared_ptr<protocol::Invoke> invoke) override
+		{
+			driver->sendData(invoke);
+		};
+		virtual void sendData(std::shared_ptr<protocol::Invoke> invoke) override
+		{
+			driver->sendData(invoke);
+		};
+	};
+
+	class EchoServer
+		: public protocol::Server
+	{
+	private:
+		std::mutex mutex;
+		std::vector<std::shared_ptr<Echo>> echos;
+
+	protected:
+		virtual void addClient(std::shared_ptr<protocol::ClientDriver> driver) override
+		{
+			std::shared_ptr<Echo> echo(new Echo());
+			echo->driver = driver;
+			{
+				std::unique_lock<std::mutex> uk(mutex);
+				echos.push_back(echo);
+			}
+			driver->listen(echo.get());
+		};
+	};
+
+	class Counter
+		: public protocol::IProtocol
+	{
+	public:
+		std::atomic<size_t> &count;
+
+		Counter(std::atomic<size_t> &count)
+			: count(count)
+		{
+		};
+
+		virtual void replyData(std::shared_ptr<protocol::Invoke>) override
+		{
+			count++;
+		};
+		virtual void sendData(std::shared_ptr<protocol::Invoke>) override
+		{
+		};
+	};
+
+	/**
+	 * Measure messages echoed per second, and CPU time spent by the kernel.
+	 *
+	 * A server and *connections* clients share an {@link protocol::IOServicePool} of *threads*, driven by *epoll*, or
+	 * by *rings* io_urings. Each client sends *messages* messages of *payload* bytes from a thread of its own, without
+	 * waiting for the echoes but within a {@link protocol::SendWindow} of 1 MB, and the server echoes them back. All
+	 * over the loopback TCP.
+	 *
+	 * Define ```SAMCHON_IO_URING``` before including the framework, or measuring io_urings throws.
+	 */
+	void measure(size_t rings, size_t threads, size_t connections, size_t messages, size_t payload, int port)
+	{
+		using namespace std;
+		using namespace samchon::protocol;
+
+		shared_ptr<IOServicePool> pool(new IOServicePool(threads));
+		pool->setIOUring(rings);
+
+		EchoServer server;
+		server.setIOServicePool(pool);
+		server.open(port);
+
+		atomic<size_t> count(0);
+		Counter counter(count);
+
+		vector<shared_ptr<ServerConnector>> clients;
+		for (size_t i = 0; i < connections; i++)
+		{
+			shared_ptr<ServerConnector> client(new ServerConnector(&counter));
+			client->setIOServicePool(pool);
+			client->setSendWindow(1024 * 1024, 512 * 1024, SendWindow::BLOCK);
+			client->connect("127.0.0.1", port);
+
+			clients.push_back(client);
+		}
+
+		rusage first_usage;
+		getrusage(RUSAGE_SELF, &first_usage);
+		auto first = chrono::steady_clock::now();
+
+		vector<thread> senders;
+		for (size_t i = 0; i < connections; i++)
+			senders.emplace_back([&, i]()
+			{
+				for (size_t j = 0; j < messages; j++)
+					clients[i]->sendData(make_shared<Invoke>("echo", string(payload, 'x')));
+			});
+		for (auto it = senders.begin(); it != senders.end(); it++)
+			it->join();
+
+		size_t total = connections * messages;
+		while (count < total && chrono::steady_clock::now() - first < chrono::seconds(60))
+			this_thread::sleep_for(chrono::microseconds(100));
+
+		double seconds = chrono::duration<double>(chrono::steady_clock::now() - first).count();
+		rusage last_usage;
+		getrusage(RUSAGE_SELF, &last_usage);
+
+		auto elapsed = [](const timeval &x, const timeval &y) -> double
+		{
+			return (y.tv_sec - x.tv_sec) * 1000.0 + (y.tv_usec - x.tv_usec) / 1000.0;
+		};
+
+		cout << "backend: " << ((rings == 0) ? "epoll" : "io_uring x" + to_string(rings))
+			<< ", echoed: " << count << "/" << total
+			<< ", elapsed: " << seconds * 1000.0 << " ms"
+			<< ", rate: " << (size_t)(count / seconds) << " msg/s"
+			<< ", user: " << elapsed(first_usage.ru_utime, last_usage.ru_utime) << " ms"
+			<< ", sys: " << elapsed(first_usage.ru_stime, last_usage.ru_stime) << " ms" << endl;
+
+		for (auto it = clients.begin(); it != clients.end(); it++)
+			(*it)->close();
+		server.close();
+		pool->stop();
+	};
+
+	void main(size_t threads = 4, size_t connections = 32, size_t messages = 20000, size_t payload = 100, int port = 20500)
+	{
+		for (size_t payload_size : { payload, payload * 40 })
+		{
+			measure(0, threads, connections, messages, payload_size, port++);
+			measure(1, threads, connections, messages, payload_size, port++);
+			measure(threads, threads, connections, messages, payload_size, port++);
+		}
+	};
+};
+};
+};
+};
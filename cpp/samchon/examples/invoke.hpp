@@ -2,6 +2,7 @@
 
 #include <iostream>
 #include <samchon/protocol/Invoke.hpp>
+#include <samchon/protocol/InvokeCodec.hpp>
 
 namespace samchon
 {
@@ -39,6 +40,32 @@ namespace invoke
 		cout << "4th param: " << endl << invoke->at(3)->getValue<shared_ptr<XML>>()->toString() << endl;
 
 		cout << shared_ptr<XML>(new XML(invoke->toXML()->toString()))->toString() << endl;
+
+		cout << "-------------------------------------------------------------" << endl;
+		cout << "	Round trip of streams" << endl;
+		cout << "-------------------------------------------------------------" << endl;
+		shared_ptr<Invoke> upload(new Invoke("upload", shared_ptr<ByteStream>(nullptr), make_shared<ByteStream>(), make_shared<ByteStream>(1024)));
+
+		// BY THE BINARY ENCODING
+		ByteArray data = InvokeCodec::encode(*upload);
+		shared_ptr<Invoke> binary = InvokeCodec::decode(data.data(), data.size());
+
+		// BY THE XML ENCODING
+		shared_ptr<Invoke> text(new Invoke());
+		text->construct(shared_ptr<XML>(new XML(upload->toXML()->toString())));
+
+		for (size_t i = 0; i < upload->size(); i++)
+		{
+			shared_ptr<ByteStream> origin = upload->at(i)->getValue<shared_ptr<ByteStream>>();
+
+			for (shared_ptr<Invoke> decoded : {binary, text})
+			{
+				shared_ptr<ByteStream> stream = decoded->at(i)->getValue<shared_ptr<ByteStream>>();
+				if ((stream == nullptr) != (origin == nullptr) || (stream != nullptr && stream->size() != origin->size()))
+					throw logic_error("a stream has changed by round trip.");
+			}
+			cout << "stream #" << i << ": " << ((origin == nullptr) ? "null" : "size " + to_string(origin->size())) << endl;
+		}
 	};
 };
 };
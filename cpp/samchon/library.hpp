@@ -30,6 +30,7 @@
 
 // MATH
 #include <samchon/library/Math.hpp>
+#include <samchon/library/Histogram.hpp>
 #include <samchon/library/GeneticAlgorithm.hpp>
 #include <samchon/library/GAPopulation.hpp>
 #include <samchon/library/GAParameters.hpp>
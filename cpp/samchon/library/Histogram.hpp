@@ -0,0 +1,296 @@
+#pragma once
+#include <samchon/API.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <climits>
+#include <cmath>
+#include <memory>
+#include <samchon/library/XML.hpp>
+
+#if defined(_MSC_VER)
+#	include <intrin.h>
+#endif
+
+namespace samchon
+{
+namespace library
+{
+	/**
+	 * A histogram of values, like latencies.
+	 *
+	 * The {@link Histogram} counts values in buckets of a logarithmic scale, dividing each power of two to
+	 * 2<sup>{@link PRECISION}</sup> buckets of a linear scale, like the *HDR Histogram*. Any value of 64 bits can be
+	 * recorded in a constant memory, and the error of a percentile is less than 1/2<sup>{@link PRECISION}</sup> of the
+	 * value; about 3%.
+	 *
+	 * Recording is lock-free, by relaxed atomic increments, so that threads can record values to a histogram at the
+	 * same time. Reading values while recording gives a snapshot roughly, not exactly.
+	 *
+	 * @author Jeongho Nam <http://samchon.org>
+	 */
+	class Histogram
+	{
+	public:
+		/**
+		 * Bits of linear buckets in a power of two.
+		 */
+		enum : size_t { PRECISION = 5 };
+
+	private:
+		enum : size_t
+		{
+			SUB_BUCKETS = (size_t)1 << PRECISION,
+			BUCKETS = (65 - PRECISION) * SUB_BUCKETS
+		};
+
+		std::array<std::atomic<unsigned long long>, BUCKETS> buckets;
+
+		std::atomic<unsigned long long> count;
+		std::atomic<unsigned long long> sum;
+		std::atomic<unsigned long long> minimum;
+		std::atomic<unsigned long long> maximum;
+
+	public:
+		/* ---------------------------------------------------------
+			CONSTRUCTORS
+		--------------------------------------------------------- */
+		/**
+		 * Default Constructor.
+		 */
+		Histogram()
+		{
+			reset();
+		};
+
+		Histogram(const Histogram &) = delete;
+		auto operator=(const Histogram &) -> Histogram& = delete;
+
+		/**
+		 * Clear all recorded values.
+		 */
+		void reset()
+		{
+			for (auto it = buckets.begin(); it != buckets.end(); it++)
+				it->store(0, std::memory_order_relaxed);
+
+			count.store(0, std::memory_order_relaxed);
+			sum.store(0, std::memory_order_relaxed);
+			minimum.store(ULLONG_MAX, std::memory_order_relaxed);
+			maximum.store(0, std::memory_order_relaxed);
+		};
+
+		/* ---------------------------------------------------------
+			RECORDERS
+		--------------------------------------------------------- */
+		/**
+		 * Record a value.
+		 *
+		 * @param value A value to record.
+		 * @param n Number of times the *value* has been observed.
+		 */
+		void record(unsigned long long value, unsigned long long n = 1)
+		{
+			buckets[index_of(value)].fetch_add(n, std::memory_order_relaxed);
+
+			count.fetch_add(n, std::memory_order_relaxed);
+			sum.fetch_add(value * n, std::memory_order_relaxed);
+
+			unsigned long long prev = minimum.load(std::memory_order_relaxed);
+			while (value < prev && minimum.compare_exchange_weak(prev, value, std::memory_order_relaxed) == false)
+				continue;
+
+			prev = maximum.load(std::memory_order_relaxed);
+			while (value > prev && maximum.compare_exchange_weak(prev, value, std::memory_order_relaxed) == false)
+				continue;
+		};
+
+		/**
+		 * Record values of another {@link Histogram}.
+		 *
+		 * @param obj Another {@link Histogram} to add.
+		 */
+		void merge(const Histogram &obj)
+		{
+			for (size_t i = 0; i < BUCKETS; i++)
+			{
+				unsigned long long n = obj.buckets[i].load(std::memory_order_relaxed);
+				if (n != 0)
+					buckets[i].fetch_add(n, std::memory_order_relaxed);
+			}
+			count.fetch_add(obj.getCount(), std::memory_order_relaxed);
+			sum.fetch_add(obj.getSum(), std::memory_order_relaxed);
+
+			if (obj.getCount() == 0)
+				return;
+
+			unsigned long long value = obj.minimum.load(std::memory_order_relaxed);
+			unsigned long long prev = minimum.load(std::memory_order_relaxed);
+			while (value < prev && minimum.compare_exchange_weak(prev, value, std::memory_order_relaxed) == false)
+				continue;
+
+			value = obj.maximum.load(std::memory_order_relaxed);
+			prev = maximum.load(std::memory_order_relaxed);
+			while (value > prev && maximum.compare_exchange_weak(prev, value, std::memory_order_relaxed) == false)
+				continue;
+		};
+
+		/* ---------------------------------------------------------
+			ACCESSORS
+		--------------------------------------------------------- */
+		/**
+		 * Get number of recorded values.
+		 */
+		auto getCount() const -> unsigned long long
+		{
+			return count.load(std::memory_order_relaxed);
+		};
+
+		/**
+		 * Get sum of recorded values.
+		 */
+		auto getSum() const -> unsigned long long
+		{
+			return sum.load(std::memory_order_relaxed);
+		};
+
+		/**
+		 * Get the minimum recorded value, 0 if nothing has been recorded.
+		 */
+		auto getMin() const -> unsigned long long
+		{
+			return (getCount() == 0) ? 0 : minimum.load(std::memory_order_relaxed);
+		};
+
+		/**
+		 * Get the maximum recorded value.
+		 */
+		auto getMax() const -> unsigned long long
+		{
+			return maximum.load(std::memory_order_relaxed);
+		};
+
+		/**
+		 * Get average of recorded values.
+		 */
+		auto getMean() const -> double
+		{
+			unsigned long long count = getCount();
+			return (count == 0) ? 0.0 : getSum() / (double)count;
+		};
+
+		/**
+		 * Get a percentile.
+		 *
+		 * @param percentage Percentage of values, from 0 to 100, equal or less than the returned value.
+		 * @return The highest value equivalent to the percentile's bucket, 0 if nothing has been recorded.
+		 */
+		auto getPercentile(double percentage) const -> unsigned long long
+		{
+			unsigned long long count = getCount();
+			if (count == 0)
+				return 0;
+
+			unsigned long long rank = (unsigned long long)std::ceil(count * std::min(std::max(percentage, 0.0), 100.0) / 100.0);
+			if (rank == 0)
+				rank = 1;
+
+			unsigned long long accumulated = 0;
+			for (size_t i = 0; i < BUCKETS; i++)
+			{
+				accumulated += buckets[i].load(std::memory_order_relaxed);
+				if (accumulated >= rank)
+					return std::min(highest_of(i), getMax());
+			}
+			return getMax();
+		};
+
+		/* ---------------------------------------------------------
+			EXPORTERS
+		--------------------------------------------------------- */
+		/**
+		 * Get an {@link XML} representing the {@link Histogram}.
+		 *
+		 * The {@link XML} has the count, sum, minimum, mean, maximum and percentiles of 50, 90, 99 and 99.9 as its
+		 * properties, and non-empty buckets as its children, with the lowest and highest values of each bucket.
+		 *
+		 * @param tag Tag name of the {@link XML}.
+		 */
+		auto toXML(const std::string &tag = "histogram") const -> std::shared_ptr<XML>
+		{
+			std::shared_ptr<XML> xml(new XML());
+			xml->setTag(tag);
+
+			xml->setProperty("count", getCount());
+			xml->setProperty("sum", getSum());
+			xml->setProperty("min", getMin());
+			xml->setProperty("mean", getMean());
+			xml->setProperty("max", getMax());
+			xml->setProperty("p50", getPercentile(50));
+			xml->setProperty("p90", getPercentile(90));
+			xml->setProperty("p99", getPercentile(99));
+			xml->setProperty("p999", getPercentile(99.9));
+
+			for (size_t i = 0; i < BUCKETS; i++)
+			{
+				unsigned long long n = buckets[i].load(std::memory_order_relaxed);
+				if (n == 0)
+					continue;
+
+				std::shared_ptr<XML> bucket(new XML());
+				bucket->setTag("bucket");
+				bucket->setProperty("from", lowest_of(i));
+				bucket->setProperty("to", highest_of(i));
+				bucket->setProperty("count", n);
+
+				xml->push_back(bucket);
+			}
+			return xml;
+		};
+
+	private:
+		/* ---------------------------------------------------------
+			BUCKETS
+		--------------------------------------------------------- */
+		static auto index_of(unsigned long long value) -> size_t
+		{
+			// EXACT UNDER 2 POWERS OF THE SUB-BUCKETS
+			if (value < 2 * SUB_BUCKETS)
+				return (size_t)value;
+
+			size_t shift = highest_bit(value) - PRECISION;
+			return shift * SUB_BUCKETS + (size_t)(value >> shift);
+		};
+
+		static auto lowest_of(size_t index) -> unsigned long long
+		{
+			if (index < 2 * SUB_BUCKETS)
+				return index;
+
+			size_t shift = index / SUB_BUCKETS - 1;
+			return (unsigned long long)(index % SUB_BUCKETS + SUB_BUCKETS) << shift;
+		};
+
+		static auto highest_of(size_t index) -> unsigned long long
+		{
+			if (index < 2 * SUB_BUCKETS)
+				return index;
+
+			size_t shift = index / SUB_BUCKETS - 1;
+			return lowest_of(index) + (((unsigned long long)1 << shift) - 1);
+		};
+
+		static auto highest_bit(unsigned long long value) -> size_t
+		{
+#if defined(_MSC_VER)
+			unsigned long index;
+			_BitScanReverse64(&index, value);
+			return index;
+#else
+			return 63 - __builtin_clzll(value);
+#endif
+		};
+	};
+};
+};
@@ -4,12 +4,27 @@
 	BASIC COMPONENTS
 ------------------------------------------------------------- */
 #include <samchon/protocol/Invoke.hpp>
+#include <samchon/protocol/InvokeCodec.hpp>
+#include <samchon/protocol/InvokePool.hpp>
+#include <samchon/protocol/Coroutine.hpp>
+#include <samchon/protocol/ByteStream.hpp>
+#include <samchon/protocol/ListenerRegistry.hpp>
+#include <samchon/protocol/Metrics.hpp>
 #include <samchon/protocol/IProtocol.hpp>
 #include <samchon/protocol/IListener.hpp>
+#include <samchon/protocol/IOServicePool.hpp>
+#include <samchon/protocol/Socket.hpp>
+#include <samchon/protocol/SharedMemorySocket.hpp>
+#include <samchon/protocol/LoopbackSocket.hpp>
+#include <samchon/protocol/IOUring.hpp>
+#include <samchon/protocol/IOUringSocket.hpp>
+#include <samchon/protocol/SocketOptions.hpp>
 
 #include <samchon/protocol/Server.hpp>
 #include <samchon/protocol/ClientDriver.hpp>
+#include <samchon/protocol/LoopbackCommunicator.hpp>
 #include <samchon/protocol/ServerConnector.hpp>
+#include <samchon/protocol/Channel.hpp>
 
 #include <samchon/protocol/WebServer.hpp>
 #include <samchon/protocol/WebClientDriver.hpp>
@@ -0,0 +1,225 @@
+#pragma once
+#include <samchon/API.hpp>
+
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+namespace samchon
+{
+namespace protocol
+{
+	/**
+	 * A stream of binary data, a parameter streamed chunk by chunk.
+	 *
+	 * The {@link ByteStream} is an alternative of *ByteArray* as a parameter of an {@link Invoke} message, for a payload
+	 * too large to hold in memory, like a file of several GB. The whole content never exists in memory at once.
+	 *
+	 * A sender feeds the {@link ByteStream} from a {@link ByteStream.file file} or a generator. A {@link Communicator}
+	 * reads a chunk from it only when the previous chunk has been written to the socket. Thus reading is throttled by the
+	 * socket's writability, and the memory used is a chunk, regardless of the stream's size. Other messages are written
+	 * between the chunks, thus a large stream doesn't block them.
+	 *
+	 * A receiver gets the {@link Invoke} message in {@link IProtocol.replyData replyData()} before chunks of its first
+	 * {@link ByteStream} arrive. The receiver must attach a sink to each {@link ByteStream} there, by
+	 * {@link setChunkListener setChunkListener()} to consume chunks through a callback, or by {@link spill spill()} to
+	 * write them to a file. Chunks arriving at a {@link ByteStream} without a sink are discarded. {@link onComplete}
+	 * tells end of the stream.
+	 *
+	 * On wire, each chunk of a {@link ByteStream} is an {@link Invoke} message of the listener ```_Stream_chunk``` 
+	 * following the {@link Invoke} message, with id of the stream and content of the chunk as a *ByteArray* parameter. 
+	 * Ids are given to the streams by order of the wire, and an empty chunk terminates a stream. A null 
+	 * {@link ByteStream}, value of a type-only parameter, has neither an id nor chunks. Both sides must know the 
+	 * {@link ByteStream}; don't send it to a remote system who doesn't.
+	 *
+	 * @see {@link InvokeParameter}, {@link Communicator}
+	 * @author Jeongho Nam <http://samchon.org>
+	 */
+	class ByteStream
+	{
+	public:
+		enum : size_t
+		{
+			/**
+			 * Size of a chunk to send, which fits in a {@link ReceiveBuffer} with its frame header.
+			 */
+			CHUNK_SIZE = 60 * 1024,
+
+			/**
+			 * Size of a stream whose size is not known.
+			 */
+			npos = (size_t)-1
+		};
+
+	private:
+		size_t size_;
+		size_t transferred_;
+
+		// SOURCE
+		std::function<size_t(unsigned char*, size_t)> source;
+
+		// SINK
+		std::function<void(const unsigned char*, size_t)> chunk_listener;
+		std::unique_ptr<std::ofstream> spill_file;
+
+	public:
+		/**
+		 * Callback function for end of the stream.
+		 *
+		 * Called after the last chunk has been received, from the listening thread.
+		 */
+		std::function<void()> onComplete;
+
+	public:
+		/* ---------------------------------------------------------
+			CONSTRUCTORS
+		--------------------------------------------------------- */
+		/**
+		 * Construct a stream to receive.
+		 *
+		 * @param size Expected size of the stream, {@link npos} if not known.
+		 */
+		ByteStream(size_t size = npos)
+		{
+			this->size_ = size;
+			this->transferred_ = 0;
+		};
+
+		/**
+		 * Construct a stream to send from a generator.
+		 *
+		 * @param source A function filling a buffer with next bytes of the stream. It returns number of the bytes filled,
+		 *				 which is zero only at end of the stream.
+		 * @param size Size of the stream, {@link npos} if not known. It is only a hint for the receiver.
+		 */
+		ByteStream(std::function<size_t(unsigned char*, size_t)> source, size_t size = npos)
+			: ByteStream(size)
+		{
+			this->source = source;
+		};
+		ByteStream(const ByteStream &) = delete;
+
+		/**
+		 * Construct a stream to send from a file.
+		 *
+		 * @param path Path of the file.
+		 * @throw invalid_argument If the file can't be opened.
+		 */
+		static auto file(const std::string &path) -> std::shared_ptr<ByteStream>
+		{
+			std::shared_ptr<std::ifstream> file(new std::ifstream(path, std::ios::binary | std::ios::ate));
+			if (file->is_open() == false)
+				throw std::invalid_argument("unable to open the file: " + path);
+
+			size_t size = (size_t)file->tellg();
+			file->seekg(0);
+
+			return std::make_shared<ByteStream>([file](unsigned char *data, size_t capacity) -> size_t
+			{
+				file->read((char*)data, capacity);
+				if (file->bad() == true)
+					throw std::runtime_error("failed to read a file to stream.");
+
+				return (size_t)file->gcount();
+			}, size);
+		};
+
+		/* ---------------------------------------------------------
+			RECEIVER
+		--------------------------------------------------------- */
+		/**
+		 * Consume chunks through a callback.
+		 *
+		 * @param listener A function called with each chunk, from the listening thread.
+		 */
+		void setChunkListener(std::function<void(const unsigned char*, size_t)> listener)
+		{
+			chunk_listener = listener;
+		};
+
+		/**
+		 * Spill chunks to a file.
+		 *
+		 * @param path Path of a file to write the stream.
+		 * @throw invalid_argument If the file can't be opened.
+		 */
+		void spill(const std::string &path)
+		{
+			spill_file.reset(new std::ofstream(path, std::ios::binary | std::ios::trunc));
+			if (spill_file->is_open() == false)
+				throw std::invalid_argument("unable to open the file: " + path);
+		};
+
+		/* ---------------------------------------------------------
+			ACCESSORS
+		--------------------------------------------------------- */
+		/**
+		 * Get size of the stream, {@link npos} if not known.
+		 */
+		auto size() const -> size_t
+		{
+			return size_;
+		};
+
+		/**
+		 * Get number of bytes sent or received so far.
+		 */
+		auto transferred() const -> size_t
+		{
+			return transferred_;
+		};
+
+		/* ---------------------------------------------------------
+			TRANSFER, BY COMMUNICATOR
+		--------------------------------------------------------- */
+		/**
+		 * Read next bytes to send.
+		 *
+		 * @param data A buffer to fill.
+		 * @param capacity Capacity of the buffer.
+		 * @return Number of bytes filled, zero at end of the stream.
+		 */
+		auto read(unsigned char *data, size_t capacity) -> size_t
+		{
+			if (source == nullptr)
+				return 0;
+
+			size_t size = source(data, capacity);
+			transferred_ += size;
+
+			return size;
+		};
+
+		/**
+		 * Deliver a received chunk to the sink.
+		 *
+		 * @param data Content of the chunk.
+		 * @param size Size of the chunk.
+		 */
+		void write(const unsigned char *data, size_t size)
+		{
+			transferred_ += size;
+
+			if (spill_file != nullptr)
+				spill_file->write((const char*)data, size);
+			if (chunk_listener != nullptr)
+				chunk_listener(data, size);
+		};
+
+		/**
+		 * Notify end of the received stream.
+		 */
+		void close()
+		{
+			if (spill_file != nullptr)
+				spill_file->close();
+
+			std::function<void()> handler = onComplete;
+			if (handler != nullptr)
+				handler();
+		};
+	};
+};
+};
@@ -0,0 +1,245 @@
+#pragma once
+#include <samchon/API.hpp>
+
+#include <samchon/protocol/Communicator.hpp>
+
+namespace samchon
+{
+namespace protocol
+{
+	/**
+	 * A logical channel over a {@link Communicator}.
+	 *
+	 * The {@link Channel} multiplexes a connection. Many channels share a {@link Communicator} and its socket, each with
+	 * its own {@link IProtocol listener}; a message sent by a {@link Channel} is delivered to the {@link Channel} of the
+	 * same ID at the remote system. Opening a channel costs neither a connection nor a handshake; both sides just
+	 * {@link open} channels of the agreed IDs.
+	 *
+	 * @code
+	 * std::shared_ptr<protocol::ServerConnector> connector(new protocol::ServerConnector(this));
+	 * connector->connect(ip, port);
+	 *
+	 * std::shared_ptr<protocol::Channel> role_a = protocol::Channel::open(connector, 1, &role_a_listener);
+	 * std::shared_ptr<protocol::Channel> role_b = protocol::Channel::open(connector, 2, &role_b_listener);
+	 *
+	 * role_a->sendData(std::make_shared<protocol::Invoke>("setData", 3));
+	 * @endcode
+	 *
+	 * A message of a {@link Channel} is sent as a copy sharing its parameters, which carries the ID as the last
+	 * parameter; the message itself is not changed. The ID is removed before the message arrives at the listener. A
+	 * message of a channel the remote system has not opened is discarded.
+	 *
+	 * Channels are not fair. Messages of all the channels are written through the {@link Communicator}'s single queue,
+	 * in order of sending, without scheduling among the channels. A channel sending a burst delays messages of the other
+	 * channels queued after it; channels only interleave message by message, as their senders do.
+	 *
+	 * The channel is closed when the {@link Channel} object is destructed. Requests by {@link call call()} and replies
+	 * by {@link sendReply sendReply()} work as they do in the {@link Communicator}.
+	 *
+	 * @see {@link Communicator}
+	 * @author Jeongho Nam <http://samchon.org>
+	 */
+	class Channel
+		: public virtual IProtocol
+	{
+	private:
+		std::weak_ptr<Communicator> communicator;
+		size_t id;
+
+		IProtocol *listener;
+
+	public:
+		/* ---------------------------------------------------------
+			CONSTRUCTORS
+		--------------------------------------------------------- */
+		/**
+		 * Open a channel.
+		 *
+		 * @param communicator A connection to share.
+		 * @param id ID of the channel, which must be same with the remote system's. Zero is reserved for the
+		 *			 *communicator* itself.
+		 * @param listener A listener of messages of the channel.
+		 *
+		 * @throw std::invalid_argument The *id* is zero or opened already.
+		 */
+		static auto open(std::shared_ptr<Communicator> communicator, size_t id, IProtocol *listener) -> std::shared_ptr<Channel>
+		{
+			if (id == 0)
+				throw std::invalid_argument("Channel #0 is reserved for the communicator.");
+
+			std::shared_ptr<Channel> channel(new Channel(communicator, id, listener));
+			communicator->open_channel(id, channel);
+
+			return channel;
+		};
+
+		/**
+		 * Close the channel.
+		 */
+		virtual ~Channel()
+		{
+			std::shared_ptr<Communicator> communicator = this->communicator.lock();
+			if (communicator != nullptr)
+				communicator->close_channel(id);
+		};
+
+	private:
+		Channel(std::shared_ptr<Communicator> communicator, size_t id, IProtocol *listener)
+		{
+			this->communicator = communicator;
+			this->id = id;
+			this->listener = listener;
+		};
+
+	public:
+		/* ---------------------------------------------------------
+			ACCESSORS
+		--------------------------------------------------------- */
+		/**
+		 * Get ID of the channel.
+		 */
+		auto getID() const -> size_t
+		{
+			return id;
+		};
+
+		/**
+		 * Get the connection, ```nullptr``` if it has been destructed.
+		 */
+		auto getCommunicator() const -> std::shared_ptr<Communicator>
+		{
+			return communicator.lock();
+		};
+
+		/**
+		 * Change the listener.
+		 */
+		void setListener(IProtocol *listener)
+		{
+			this->listener = listener;
+		};
+
+		/* ---------------------------------------------------------
+			INVOKE MESSAGE CHAIN
+		--------------------------------------------------------- */
+		/**
+		 * Handle a message of the channel.
+		 *
+		 * @param invoke An {@link Invoke} message received from the remote system's {@link Channel}.
+		 */
+		virtual void replyData(std::shared_ptr<Invoke> invoke) override
+		{
+			IListener *i_listener = dynamic_cast<IListener*>(listener);
+			if (i_listener != nullptr)
+				i_listener->_Reply_data(invoke);
+			else if (listener != nullptr)
+				listener->replyData(invoke);
+		};
+
+		/**
+		 * Send a message through the channel.
+		 *
+		 * @param invoke An {@link Invoke} message to send.
+		 */
+		virtual void sendData(std::shared_ptr<Invoke> invoke) override
+		{
+			sendData(invoke, nullptr);
+		};
+
+		/**
+		 * Send a message through the channel, with a callback.
+		 *
+		 * @param invoke An {@link Invoke} message to send.
+		 * @param callback A function called with result of the writing. If the connection has been destructed, it's
+		 *				   called with ```boost::asio::error::not_connected``` directly.
+		 */
+		void sendData(std::shared_ptr<Invoke> invoke, std::function<void(const boost::system::error_code&)> callback)
+		{
+			std::shared_ptr<Communicator> communicator = this->communicator.lock();
+			if (communicator == nullptr)
+			{
+				if (callback != nullptr)
+					callback(boost::asio::error::not_connected);
+				return;
+			}
+
+			// THE CALLER'S INVOKE IS NOT TOUCHED
+			std::shared_ptr<Invoke> tagged = Communicator::copy_message(*invoke);
+			Communicator::push_channel(*tagged, id);
+
+			communicator->sendData(tagged, callback);
+		};
+
+		/* ---------------------------------------------------------
+			REQUEST AND REPLY
+		--------------------------------------------------------- */
+		/**
+		 * Send a request through the channel and get a future of its reply.
+		 *
+		 * @param invoke An {@link Invoke} message to send.
+		 * @param timeout Time to wait for the reply. Zero, the default, waits until the connection is closed.
+		 * @return A future of the reply.
+		 * @see {@link Communicator.call}
+		 */
+		auto call(std::shared_ptr<Invoke> invoke, std::chrono::steady_clock::duration timeout = std::chrono::steady_clock::duration::zero()) -> std::future<std::shared_ptr<Invoke>>
+		{
+			std::shared_ptr<std::promise<std::shared_ptr<Invoke>>> promise(new std::promise<std::shared_ptr<Invoke>>());
+			std::future<std::shared_ptr<Invoke>> future = promise->get_future();
+
+			call(invoke, [promise](std::shared_ptr<Invoke> reply, std::exception_ptr error)
+			{
+				if (error != nullptr)
+					promise->set_exception(error);
+				else
+					promise->set_value(reply);
+			}, timeout);
+
+			return future;
+		};
+
+		/**
+		 * Send a request through the channel and get its reply by a callback.
+		 *
+		 * @param invoke An {@link Invoke} message to send.
+		 * @param handler A function called with the reply, or with the error.
+		 * @param timeout Time to wait for the reply. Zero waits until the connection is closed.
+		 */
+		void call(std::shared_ptr<Invoke> invoke, PendingCalls::Handler handler, std::chrono::steady_clock::duration timeout = std::chrono::steady_clock::duration::zero())
+		{
+			std::shared_ptr<Communicator> communicator = this->communicator.lock();
+			if (communicator == nullptr)
+				handler(nullptr, std::make_exception_ptr(boost::system::system_error(boost::asio::error::not_connected)));
+			else
+				communicator->send_call(invoke, handler, timeout, id);
+		};
+
+#ifdef SAMCHON_COROUTINE
+		/**
+		 * Send a request through the channel and await its reply in a coroutine.
+		 *
+		 * @param invoke An {@link Invoke} message to send.
+		 * @param timeout Time to wait for the reply. Zero waits until the connection is closed.
+		 * @return An {@link Awaitable} of the reply.
+		 */
+		auto asyncCall(std::shared_ptr<Invoke> invoke, std::chrono::steady_clock::duration timeout = std::chrono::steady_clock::duration::zero()) -> Awaitable<std::shared_ptr<Invoke>>
+		{
+			return Awaitable<std::shared_ptr<Invoke>>([this, invoke, timeout](Awaitable<std::shared_ptr<Invoke>>::Handler handler)
+			{
+				call(invoke, handler, timeout);
+			});
+		};
+#endif
+
+		/**
+		 * Send a reply of a request received through the channel.
+		 *
+		 * @param request An {@link Invoke} message received, as a request.
+		 * @param reply An {@link Invoke} message to reply.
+		 */
+		void sendReply(const Invoke &request, std::shared_ptr<Invoke> reply)
+		{
+			sendData(Communicator::reply_of(request, reply));
+		};
+	};
+};
+};
@@ -37,8 +37,10 @@ namespace protocol
 	class ClientDriver
 		: public virtual Communicator
 	{
+		friend class Server;
+
 	public:
-		ClientDriver(std::shared_ptr<boost::asio::ip::tcp::socket> socket)
+		ClientDriver(std::shared_ptr<Socket> socket)
 			: Communicator()
 		{
 			this->socket = socket;
@@ -52,6 +54,9 @@ namespace protocol
 		 * converted to {@link Invoke} classes and shifted to the *listener*'s {@link IProtocol.replyData replyData()} 
 		 * method. 
 		 * 
+		 * In the blocking mode, it returns after the connection has been closed. If the {@link Server} is working in the
+		 * asynchronous mode, it returns immediately; use {@link onClose} to be notified of disconnection.
+		 * 
 		 * @param listener A listener object to listen replied message from newly connected client in 
 		 *				   {@link IProtocol.replyData replyData()} as an {@link Invoke} object.
 		 */
@@ -59,7 +64,7 @@ namespace protocol
 		{
 			this->listener = listener;
 
-			listen_message();
+			start_listening();
 		};
 	};
 };
@@ -3,13 +3,34 @@
 
 #include <samchon/protocol/IProtocol.hpp>
 #include <samchon/protocol/IListener.hpp>
+#include <samchon/protocol/Coroutine.hpp>
+#include <samchon/protocol/InvokeCodec.hpp>
+#include <samchon/protocol/InvokePool.hpp>
+#include <samchon/protocol/Metrics.hpp>
+#include <samchon/protocol/OutboundQueue.hpp>
+#include <samchon/protocol/PendingCalls.hpp>
+#include <samchon/protocol/ReceiveBuffer.hpp>
+#include <samchon/protocol/SendWindow.hpp>
+#include <samchon/protocol/Socket.hpp>
+#include <samchon/ByteArrayCompression.hpp>
 
 #include <iostream>
 #include <array>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <future>
+#include <queue>
 #include <exception>
+#include <functional>
 #include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
 #include <boost/asio.hpp>
 #include <samchon/ByteArray.hpp>
+#include <samchon/protocol/IOServicePool.hpp>
 
 namespace samchon
 {
@@ -31,6 +52,29 @@ namespace protocol
 	 * class who follows the Samchon Framework's own protocol. Web-browser supports only Web-socket protocol. Thus in that 
 	 * case, you have to use {@link WebCommunicator} instead.
 	 *
+	 * A {@link Communicator} works in one of two modes. By default, a thread is dedicated to the connection and blocked
+	 * in listening messages. If an {@link IOServicePool} is given (to the {@link Server} or {@link ServerConnector}), 
+	 * the {@link Communicator} reads and writes asynchronously on the pool's threads instead. In the asynchronous mode,
+	 * the {@link Communicator} must be owned by a ```std::shared_ptr```.
+	 *
+	 * Besides the fire-and-forget {@link sendData sendData()}, a request expecting a reply can be sent by
+	 * {@link call call()}. Requests are correlated with their replies by IDs, so that many of them can be outstanding
+	 * on a connection at a time. The remote system answers by {@link sendReply sendReply()}.
+	 *
+	 * Bytes queued for a slow remote system are bounded by a {@link SendWindow}, configured by
+	 * {@link setSendWindow setSendWindow()}. Over its high watermark, senders are blocked, the oldest or superseded 
+	 * messages are dropped, or the connection is closed, by the chosen policy; {@link onHighWatermark} and 
+	 * {@link onLowWatermark} tell when the remote system goes over its budget and comes back.
+	 *
+	 * A connection can be shared by many logical {@link Channel channels}, each with its own listener. Messages of a
+	 * {@link Channel} are delivered to the {@link Channel} of the same ID at the remote system, instead of the
+	 * {@link IProtocol listener} of the {@link Communicator}. The channels share the sending queue in FIFO order; they
+	 * are not scheduled fairly.
+	 *
+	 * Traffic of a connection is counted by its {@link getMetrics Metrics}; bytes and messages in both directions,
+	 * depth of the sending queue and time spent by handlers of each listener name. They can be read in the process, or
+	 * queried by the remote system with the reserved {@link Metrics.QUERY_LISTENER _Metrics} listener.
+	 *
 	 * ![Basic Components](http://samchon.github.io/framework/images/design/cpp_class_diagram/protocol_basic_components.png)
 	 *
 	 * @see {@link ClientDriver}, {@link ServerConnector}, {@link IProtocol}
@@ -38,18 +82,183 @@ namespace protocol
 	 * @author Jeongho Nam <http://samchon.org>
 	 */
 	class Communicator 
-		: public virtual IProtocol
+		: public virtual IProtocol,
+		public std::enable_shared_from_this<Communicator>
 	{
+		friend class Channel;
+
 	protected:
-		std::shared_ptr<boost::asio::ip::tcp::socket> socket;
+		/**
+		 * A stream to the remote system, of any transport.
+		 */
+		std::shared_ptr<Socket> socket;
 		IProtocol *listener;
 
-		std::mutex send_mtx;
+		/**
+		 * Reactor of the asynchronous mode, ```nullptr``` in the blocking mode.
+		 */
+		std::shared_ptr<IOServicePool> service_pool;
+
+		/**
+		 * Serializes handlers of this connection in the asynchronous mode.
+		 */
+		std::unique_ptr<boost::asio::io_service::strand> strand;
+
+		/**
+		 * Whether to send {@link Invoke} messages in the {@link InvokeCodec binary encoding}.
+		 * 
+		 * It becomes ```true``` only when both sides have agreed on the binary encoding. Received messages are decoded 
+		 * by their own encoding, regardless of this flag.
+		 */
+		std::atomic<bool> binary_encoding;
+
+		/**
+		 * Whether to compress frames larger than the {@link compression_threshold}.
+		 * 
+		 * It becomes ```true``` only when both sides have agreed on the compression. Received frames are decompressed by 
+		 * their own flag, regardless of this.
+		 */
+		std::atomic<bool> compression;
+
+		/**
+		 * Frames smaller than it are not compressed. Default is 1 KB.
+		 */
+		size_t compression_threshold;
+
+		/**
+		 * Maximum size of a received frame, after decompression. Default is 1 GB.
+		 */
+		size_t max_frame_size;
+
+		/**
+		 * An {@link Invoke} message waiting for contents of its *ByteArray* parameters.
+		 */
+		std::shared_ptr<Invoke> binary_invoke;
+
+		/**
+		 * *ByteArray* parameters of the {@link binary_invoke}, whose contents have not arrived yet.
+		 */
+		std::queue<std::shared_ptr<InvokeParameter>> binary_parameters;
+
+		/**
+		 * Received {@link ByteStream} parameters whose chunks are arriving, by their ids.
+		 */
+		std::unordered_map<size_t, std::shared_ptr<ByteStream>> binary_streams;
+
+		/**
+		 * Bytes read from the socket, not parsed yet.
+		 */
+		ReceiveBuffer receive_buffer;
+
+		/**
+		 * Destination of a large frame's remainder, which is read directly from the socket.
+		 */
+		unsigned char *large_frame;
+
+	private:
+		// CONTENT OF A LARGE FRAME
+		std::string content;
+
+		// IDS OF STREAMS, BY ORDER OF THE WIRE
+		size_t sent_streams;
+		size_t received_streams;
+
+		// A LARGE FRAME WHICH IS COMPRESSED
+		bool large_compressed;
+		ByteArray compressed_frame;
+
+		// WRITE
+		OutboundQueue send_queue;
+		SendWindow send_window;
+		std::atomic<bool> high_watermark_reached;
+
+		// MESSAGES POPPED BY SHEDDING SENDERS, TO BE TAKEN BY THE WRITER
+		std::mutex backlog_mutex;
+		std::vector<std::shared_ptr<OutboundMessage>> backlog;
+		size_t backlog_count;
+
+		// REQUESTS WAITING FOR THEIR REPLIES
+		std::shared_ptr<PendingCalls> pending_calls;
+
+		// LOGICAL CHANNELS, BY THEIR IDS
+		std::mutex channels_mutex;
+		std::unordered_map<size_t, std::weak_ptr<IProtocol>> channels;
+
+		// METRICS, WITH THE HOT ONES REFERRED DIRECTLY
+		Metrics metrics;
+		Metrics::Counter *bytes_in;
+		Metrics::Counter *bytes_out;
+		Metrics::Counter *messages_in;
+		Metrics::Counter *messages_out;
+		Metrics::Counter *messages_dropped;
+		library::Histogram *handler_time;
+
+		std::atomic<size_t> queued_messages;
+
+		// HISTOGRAMS OF THE HANDLER TIME BY LISTENER, RESOLVED ONCE AND TOUCHED BY THE RECEIVING SIDE ONLY
+		std::unordered_map<std::string, library::Histogram*> listener_times;
+
+	public:
+		/**
+		 * Callback function for disconnection.
+		 */
+		std::function<void()> onClose;
+
+		/**
+		 * Callback function for an error which closes the connection, like a malformed frame or an exception thrown by
+		 * the listener. It's called before the {@link onClose}.
+		 */
+		std::function<void(std::exception_ptr)> onError;
+
+		/**
+		 * Callback function for reaching the high watermark of the {@link SendWindow}, with bytes queued.
+		 */
+		std::function<void(size_t)> onHighWatermark;
+
+		/**
+		 * Callback function for falling to the low watermark of the {@link SendWindow}, with bytes queued.
+		 */
+		std::function<void(size_t)> onLowWatermark;
 
 	public:
 		Communicator()
 		{
 			listener = nullptr;
+			binary_encoding = false;
+			compression = false;
+			compression_threshold = 1024;
+			max_frame_size = 1024 * 1024 * 1024;
+
+			large_frame = nullptr;
+			sent_streams = 0;
+			received_streams = 0;
+			large_compressed = false;
+			high_watermark_reached = false;
+			backlog_count = 0;
+
+			pending_calls = std::make_shared<PendingCalls>();
+
+			bytes_in = &metrics.counter("bytes.in");
+			bytes_out = &metrics.counter("bytes.out");
+			messages_in = &metrics.counter("messages.in");
+			messages_out = &metrics.counter("messages.out");
+			messages_dropped = &metrics.counter("messages.dropped");
+			handler_time = &metrics.histogram("handler");
+
+			queued_messages = 0;
+
+			metrics.gauge("queue.bytes", [this]() -> unsigned long long
+			{
+				return send_window.size();
+			});
+			metrics.gauge("queue.messages", [this]() -> unsigned long long
+			{
+				return queued_messages.load();
+			});
+			metrics.gauge("calls.pending", [this]() -> unsigned long long
+			{
+				return pending_calls->size();
+			});
 		};
 		virtual ~Communicator()
 		{
@@ -61,8 +270,24 @@ namespace protocol
 		 */
 		virtual void close()
 		{
+			// BOTH OF THE USER AND THE LISTENING SIDE MAY CLOSE
+			boost::system::error_code error;
 			if (socket != nullptr && socket->is_open())
-				socket->close();
+				socket->close(error);
+
+			// NOTHING WILL BE WRITTEN
+			send_window.close();
+
+			// NO REPLY WILL ARRIVE
+			pending_calls->rejectAll(std::make_exception_ptr(boost::system::system_error(boost::asio::error::connection_aborted)));
+		};
+
+		/**
+		 * Test whether the {@link Communicator} works in the asynchronous mode, driven by an {@link IOServicePool}.
+		 */
+		auto isAsynchronous() const -> bool
+		{
+			return service_pool != nullptr;
 		};
 
 		/**
@@ -75,6 +300,10 @@ namespace protocol
 		*/
 		virtual void replyData(std::shared_ptr<Invoke> invoke)
 		{
+			if (handle_negotiation(invoke) == true || handle_stream(invoke) == true || handle_channel(invoke) == true 
+				|| handle_call(invoke) == true || handle_metrics(invoke) == true)
+				return;
+
 			IListener *i_listener = dynamic_cast<IListener*>(listener);
 			if (i_listener != nullptr)
 				i_listener->_Reply_data(invoke);
@@ -87,150 +316,1503 @@ namespace protocol
 		*
 		* Send the {@link Invoke} message to remote system.
 		*
+		* The {@link Invoke} message is enqueued to be written, without locking. One of the sending threads is elected as
+		* the writer and writes all the queued messages by few large writes, while the others return immediately. In the
+		* asynchronous mode, the I/O service writes and no sending thread waits.
+		*
+		* Contents of the *ByteArray* parameters are not copied; don't modify them after sending.
+		*
+		* {@link ByteStream} parameters are read and written chunk by chunk after the {@link Invoke} message, each chunk
+		* as a message of its own and after the previous one has been written. Thus other messages are written between
+		* the chunks, and the {@link SendWindow} counts the chunks too. In the blocking mode, the writer thread doesn't 
+		* return until the queue gets idle, thus until the whole streams have been written.
+		*
 		* @param invoke An {@link Invoke} message to send.
 		*/
 		virtual void sendData(std::shared_ptr<Invoke> invoke)
 		{
-			std::unique_lock<std::mutex> uk(send_mtx);
+			sendData(invoke, nullptr);
+		};
+
+		/**
+		* Send message with a callback.
+		*
+		* Send the {@link Invoke} message to remote system, and get notified when it has been written.
+		*
+		* @param invoke An {@link Invoke} message to send.
+		* @param callback A function called with result of the writing, from the writer's thread. If the *invoke* has
+		*				  {@link ByteStream} parameters, it's called after all of them have been written.
+		*/
+		void sendData(std::shared_ptr<Invoke> invoke, std::function<void(const boost::system::error_code&)> callback)
+		{
+			// THE WRITER NEVER WAITS FOR ITSELF
+			if (writing() != this && (strand == nullptr || strand->running_in_this_thread() == false))
+				send_window.wait();
 
-			// SEND INVOKE
-			send_data(invoke->toXML()->toString());
+			// ONLY THE ELECTED WRITER CONTINUES
+			bool writer = enqueue_message(invoke, callback);
+			handle_high_watermark();
 
-			// SEND BINARY
-			for (size_t i = 0; i < invoke->size(); i++)
-				if (invoke->at(i)->getType() == "ByteArray")
-					send_data(invoke->at(i)->referValue<ByteArray>());
+			if (writer == true)
+				write_messages();
+			else
+				shed_backlog();
 		};
 
-	protected:
-		/* =========================================================
-			SOCKET I/O
-				- READ
-				- WRITE
-		============================================================
-			READ
+		/* ---------------------------------------------------------
+			SEND WINDOW
 		--------------------------------------------------------- */
-		virtual void listen_message()
+		/**
+		 * Bound bytes queued for the remote system.
+		 *
+		 * The {@link SendWindow.BLOCK BLOCK} policy blocks the sending threads, not the I/O threads writing this 
+		 * connection. Don't choose it for a connection which I/O threads of an {@link IOServicePool} send to.
+		 *
+		 * The {@link SendWindow.DROP_OLDEST DROP_OLDEST} and {@link SendWindow.COALESCE COALESCE} policies drop
+		 * messages which have not been written yet; their callbacks get ```boost::asio::error::no_buffer_space```.
+		 *
+		 * In the blocking mode, the thread elected as the writer still waits for the socket; the window bounds what 
+		 * the other sending threads queue meanwhile. In the asynchronous mode, no sending thread waits for the socket.
+		 *
+		 * @param high_watermark Bytes making the remote system a slow consumer. Zero, the default, means unbounded.
+		 * @param low_watermark Bytes making the remote system healthy again.
+		 * @param policy A {@link SendWindow.Policy policy} for the slow consumer.
+		 */
+		void setSendWindow(size_t high_watermark, size_t low_watermark, SendWindow::Policy policy)
 		{
-			std::shared_ptr<Invoke> binary_invoke = nullptr;
-			std::queue<std::shared_ptr<InvokeParameter>> binary_parameters;
+			send_window.configure(high_watermark, low_watermark, policy);
+		};
 
-			while (true)
+		/**
+		 * Get the {@link SendWindow}.
+		 */
+		auto getSendWindow() -> SendWindow&
+		{
+			return send_window;
+		};
+
+		/* ---------------------------------------------------------
+			FRAME SIZE
+		--------------------------------------------------------- */
+		/**
+		 * Bound size of frames received from the remote system.
+		 *
+		 * A frame is an {@link Invoke} message or content of its *ByteArray* parameter. A frame declaring a larger size,
+		 * or inflated to a larger size by decompression, closes the connection before its memory is allocated. Set it
+		 * before listening.
+		 *
+		 * @param size Maximum size of a frame in bytes. Default is 1 GB.
+		 */
+		void setMaxFrameSize(size_t size)
+		{
+			max_frame_size = size;
+		};
+
+		/**
+		 * Get maximum size of a received frame.
+		 */
+		auto getMaxFrameSize() const -> size_t
+		{
+			return max_frame_size;
+		};
+
+		/* ---------------------------------------------------------
+			METRICS
+		--------------------------------------------------------- */
+		/**
+		 * Get the {@link Metrics}.
+		 *
+		 * A {@link Communicator} counts:
+		 *
+		 *	- ```bytes.in```, ```bytes.out```: bytes read from and written to the socket.
+		 *	- ```messages.in```, ```messages.out```: {@link Invoke} messages received and sent; a message is counted as
+		 *	  sent after it has been written successfully.
+		 *	- ```messages.dropped```: messages dropped by the {@link SendWindow}.
+		 *	- ```queue.bytes```, ```queue.messages```: gauges of bytes and messages queued, not written yet.
+		 *	- ```calls.pending```: a gauge of {@link getPendingCalls requests waiting for their replies}.
+		 *	- ```handler```: a histogram of nanoseconds spent by {@link replyData replyData()} for a message.
+		 *	- ```handler.{listener}```: the same, for each listener name, up to {@link MAX_HANDLER_LISTENERS} names.
+		 *
+		 * Subclasses and users may add their own metrics.
+		 */
+		auto getMetrics() -> Metrics&
+		{
+			return metrics;
+		};
+
+		/**
+		 * Maximum number of listener names having their own histograms of the handler time.
+		 *
+		 * Listener names are chosen by the remote system; messages of the other names are counted by the
+		 * ```handler``` histogram only.
+		 */
+		static const size_t MAX_HANDLER_LISTENERS = 64;
+
+		/* ---------------------------------------------------------
+			REQUEST AND REPLY
+		--------------------------------------------------------- */
+		/**
+		 * Send a request and get a future of its reply.
+		 *
+		 * A copy of the *invoke*, sharing its parameters, is sent with a {@link PendingCalls.CALL_UID} parameter at its
+		 * end, to be correlated with its reply; the *invoke* itself is not changed. The remote system's listener gets the
+		 * request without the parameter, and must answer by {@link sendReply sendReply()}. Requests don't wait for
+		 * replies of the previous ones; any number of them can be outstanding.
+		 *
+		 * The future fails by ```boost::system::system_error``` when the request can't be written, when the timeout
+		 * has elapsed (```boost::asio::error::timed_out```) or when the connection has been closed
+		 * (```boost::asio::error::connection_aborted```).
+		 *
+		 * @param invoke An {@link Invoke} message to send.
+		 * @param timeout Time to wait for the reply. Zero, the default, waits until the connection is closed.
+		 * @return A future of the reply.
+		 */
+		auto call(std::shared_ptr<Invoke> invoke, std::chrono::steady_clock::duration timeout = std::chrono::steady_clock::duration::zero()) -> std::future<std::shared_ptr<Invoke>>
+		{
+			std::shared_ptr<std::promise<std::shared_ptr<Invoke>>> promise(new std::promise<std::shared_ptr<Invoke>>());
+			std::future<std::shared_ptr<Invoke>> future = promise->get_future();
+
+			call(invoke, [promise](std::shared_ptr<Invoke> reply, std::exception_ptr error)
 			{
-				try
-				{
-					// READ CONTENT SIZE
-					size_t content_size = listen_size();
+				if (error != nullptr)
+					promise->set_exception(error);
+				else
+					promise->set_value(reply);
+			}, timeout);
 
-					// READ CONTENT
-					if (binary_invoke == nullptr)
-					{
-						std::shared_ptr<Invoke> invoke = listen_string(content_size);
+			return future;
+		};
 
-						for (size_t i = 0; i < invoke->size(); i++)
-						{
-							std::shared_ptr<InvokeParameter> &parameter = invoke->at(i);
-							if (parameter->getType() != "ByteArray")
-								continue;
-
-							if (binary_invoke == nullptr)
-								binary_invoke = invoke;
-							binary_parameters.push(parameter);
-						}
-
-						// NO BINARY, THEN REPLY DIRECTLY
-						if (binary_invoke == nullptr)
-							this->replyData(invoke);
-					}
-					else
-					{
-						std::shared_ptr<InvokeParameter> parameter = binary_parameters.front();
-						listen_binary(content_size, parameter);
-						binary_parameters.pop();
+		/**
+		 * Send a request and get its reply by a callback.
+		 *
+		 * Same with {@link call call()} returning a future, but the *handler* is called from the thread receiving the
+		 * reply, or detecting the failure. Don't block in it.
+		 *
+		 * @param invoke An {@link Invoke} message to send.
+		 * @param handler A function called with the reply, or with the error.
+		 * @param timeout Time to wait for the reply. Zero waits until the connection is closed.
+		 */
+		void call(std::shared_ptr<Invoke> invoke, PendingCalls::Handler handler, std::chrono::steady_clock::duration timeout = std::chrono::steady_clock::duration::zero())
+		{
+			send_call(invoke, handler, timeout, 0);
+		};
 
-						if (binary_parameters.empty() == true)
-						{
-							// NO BINARY PARAMETER LEFT,
-							std::shared_ptr<Invoke> invoke = binary_invoke;
-							binary_invoke = nullptr;
+#ifdef SAMCHON_COROUTINE
+		/**
+		 * Send a request and await its reply in a coroutine.
+		 *
+		 * Same with {@link call call()} returning a future, but the reply is awaited by ```co_await```, without
+		 * blocking a thread. The coroutine is resumed from the thread receiving the reply, or detecting the failure.
+		 *
+		 * @code
+		 * std::shared_ptr<protocol::Invoke> reply = co_await communicator->asyncCall(invoke);
+		 * @endcode
+		 *
+		 * @param invoke An {@link Invoke} message to send.
+		 * @param timeout Time to wait for the reply. Zero waits until the connection is closed.
+		 * @return An {@link Awaitable} of the reply.
+		 */
+		auto asyncCall(std::shared_ptr<Invoke> invoke, std::chrono::steady_clock::duration timeout = std::chrono::steady_clock::duration::zero()) -> Awaitable<std::shared_ptr<Invoke>>
+		{
+			return Awaitable<std::shared_ptr<Invoke>>([this, invoke, timeout](Awaitable<std::shared_ptr<Invoke>>::Handler handler)
+			{
+				call(invoke, handler, timeout);
+			});
+		};
+#endif
 
-							// THEN REPLY
-							this->replyData(invoke);
-						}
-					}
-				}
-				catch (std::exception &e)
-				{
-					std::cout << "Reason of disconnection: " << e.what() << std::endl;
-					break;
-				}
-				catch (...)
-				{
-					break;
-				}
-			}
+		/**
+		 * Send a reply of a request.
+		 *
+		 * A copy of the *reply*, sharing its parameters, is sent with a {@link PendingCalls.REPLY_UID} parameter at its
+		 * end, which correlates it with the *request*; the *reply* itself is not changed. If the *request* was not sent
+		 * by {@link call call()}, the *reply* is sent as it is.
+		 *
+		 * @param request An {@link Invoke} message received, as a request.
+		 * @param reply An {@link Invoke} message to reply.
+		 */
+		void sendReply(const Invoke &request, std::shared_ptr<Invoke> reply)
+		{
+			sendData(reply_of(request, reply));
+		};
+
+		/**
+		 * Get number of requests waiting for their replies.
+		 */
+		auto getPendingCalls() const -> size_t
+		{
+			return pending_calls->size();
 		};
 
 	private:
-		auto listen_size() -> size_t
+		void send_call(std::shared_ptr<Invoke> invoke, PendingCalls::Handler handler, std::chrono::steady_clock::duration timeout, size_t channel)
 		{
-			std::array<unsigned char, 8> size_header;
-			listen_data(size_header);
+			std::shared_ptr<PendingCalls> calls = pending_calls;
 
-			size_t size = 0;
-			for (size_t c = 0; c < size_header.size(); c++)
-				size += size_header[c] << (8 * (size_header.size() - 1 - c));
+			size_t uid = (timeout == std::chrono::steady_clock::duration::zero())
+				? calls->push(handler)
+				: calls->push(handler, timeout, (service_pool != nullptr) ? service_pool->getService() : PendingCalls::getTimerService());
 
-			return size;
+			// THE CALLER'S INVOKE IS NOT TOUCHED
+			std::shared_ptr<Invoke> request = copy_message(*invoke);
+			request->push_back(InvokePool::get().createParameter(PendingCalls::CALL_UID(), uid));
+
+			if (channel != 0)
+				push_channel(*request, channel);
+
+			sendData(request, [calls, uid](const boost::system::error_code &error)
+			{
+				if (error)
+					calls->reject(uid, std::make_exception_ptr(boost::system::system_error(error)));
+			});
 		};
 
-		auto listen_string(size_t size) -> std::shared_ptr<Invoke>
+		static auto reply_of(const Invoke &request, std::shared_ptr<Invoke> reply) -> std::shared_ptr<Invoke>
 		{
-			// READ CONTENT
-			std::string data(size, (char)NULL);
-			listen_data(data);
+			if (request.call_uid == 0)
+				return reply;
 
-			// CONSTRUCT INVOKE OBJECT
-			std::shared_ptr<Invoke> invoke(new Invoke());
-			invoke->construct(std::make_shared<library::XML>(data));
+			std::shared_ptr<Invoke> tagged = copy_message(*reply);
+			tagged->push_back(InvokePool::get().createParameter(PendingCalls::REPLY_UID(), request.call_uid));
 
-			return invoke;
+			return tagged;
+		};
+
+	protected:
+		/**
+		 * Copy an {@link Invoke} message shallowly, sharing its parameters.
+		 * 
+		 * A message to send is tagged on its copy, so that the caller's message is not changed.
+		 * 
+		 * @param invoke An {@link Invoke} message to copy.
+		 * @return A new {@link Invoke} message of the same listener and parameters.
+		 */
+		static auto copy_message(const Invoke &invoke) -> std::shared_ptr<Invoke>
+		{
+			std::shared_ptr<Invoke> copy = InvokePool::get().createInvoke(invoke.getListener());
+			copy->assign(invoke.begin(), invoke.end());
+
+			return copy;
+		};
+
+		/**
+		 * Pack an {@link Invoke} message and enqueue it to be written.
+		 * 
+		 * Messages are written in order of enqueueing. An override may serialize packing and enqueueing, if packing of a
+		 * message depends on the previous ones.
+		 * 
+		 * @param invoke An {@link Invoke} message to send.
+		 * @param callback A function called with result of the writing.
+		 * @return Whether the calling thread has been elected as the writer.
+		 */
+		virtual auto enqueue_message(std::shared_ptr<Invoke> invoke, std::function<void(const boost::system::error_code&)> callback) -> bool
+		{
+			std::shared_ptr<OutboundMessage> message = pack_message(invoke);
+			message->setCallback(stream_callback(invoke, callback));
+
+			return push_message(message);
+		};
+
+		/**
+		 * Send a message packed already, like a control frame of a protocol.
+		 * 
+		 * @param message An {@link OutboundMessage} to write.
+		 */
+		void send_message(std::shared_ptr<OutboundMessage> message)
+		{
+			bool writer = push_message(message);
+			handle_high_watermark();
+
+			if (writer == true)
+				write_messages();
+			else
+				shed_backlog();
+		};
+
+		/**
+		 * Test whether a message not written yet can be dropped by the {@link SendWindow}.
+		 *
+		 * Control frames are never dropped. An override returns ```false``` if packing of a message depends on the 
+		 * previous ones, like a compression context.
+		 *
+		 * @param message An {@link OutboundMessage} of an {@link Invoke}.
+		 */
+		virtual auto is_droppable(const OutboundMessage &message) const -> bool
+		{
+			return true;
+		};
+
+		/**
+		 * Pack an {@link Invoke} message to frames.
+		 * 
+		 * @param invoke An {@link Invoke} message to send.
+		 * @return An {@link OutboundMessage} containing frames of the *invoke* and its *ByteArray* parameters.
+		 */
+		virtual auto pack_message(std::shared_ptr<Invoke> invoke) -> std::shared_ptr<OutboundMessage>
+		{
+			std::shared_ptr<OutboundMessage> message(new OutboundMessage(invoke));
+
+			// PACK INVOKE
+			if (binary_encoding == true)
+				pack_frame(*message, InvokeCodec::encode(*invoke));
+			else
+				pack_frame(*message, invoke->toXML()->toString());
+
+			// PACK BINARY
+			for (size_t i = 0; i < invoke->size(); i++)
+				if (invoke->at(i)->getTypeCode() == InvokeParameter::BYTE_ARRAY)
+					pack_frame(*message, invoke->at(i)->referValue<ByteArray>());
+
+			return message;
+		};
+
+		/**
+		 * Switch to the asynchronous mode.
+		 * 
+		 * @param pool Reactor to drive this {@link Communicator}.
+		 */
+		void set_service_pool(std::shared_ptr<IOServicePool> pool)
+		{
+			service_pool = pool;
+			strand.reset(new boost::asio::io_service::strand(pool->getService()));
+		};
+
+		/**
+		 * Start listening messages.
+		 * 
+		 * In the blocking mode, it returns after the connection has been closed. In the asynchronous mode, it returns
+		 * immediately.
+		 */
+		void start_listening()
+		{
+			// A RECONNECTION, AFTER THE WINDOW HAS BEEN CLOSED
+			send_window.open();
+
+			if (service_pool == nullptr)
+				listen_message();
+			else
+				listen_message_async();
+		};
+
+		/**
+		 * Handle disconnection.
+		 *
+		 * @param error An error closing the connection, to be reported to the {@link onError}, if any.
+		 */
+		void handle_close(std::exception_ptr error = nullptr)
+		{
+			close();
+
+			std::function<void(std::exception_ptr)> error_handler = onError;
+			if (error != nullptr && error_handler != nullptr)
+				error_handler(error);
+
+			std::function<void()> handler = onClose;
+			if (handler != nullptr)
+				handler();
 		};
 
-		void listen_binary(size_t size, std::shared_ptr<InvokeParameter> parameter)
+		/* =========================================================
+			ENCODING NEGOTIATION
+		========================================================= */
+		/**
+		 * Offer encodings to the remote system.
+		 * 
+		 * The offer is an ordinary {@link Invoke} message following the XML encoding. A remote system who does not know 
+		 * an encoding just ignores it, as an unknown parameter, and both sides keep going without the encoding.
+		 * 
+		 * Note that a remote system who does not know the negotiation at all, like a former version, shifts the offer 
+		 * to its listener as an ordinary {@link Invoke} message of the listener ```_Offer_encoding```. Its listener 
+		 * must ignore the message, or don't offer to such a system.
+		 * 
+		 * @param binary Whether to offer the {@link InvokeCodec binary encoding}.
+		 * @param compression Whether to offer compression of frames.
+		 */
+		void offer_encodings(bool binary, bool compression)
 		{
-			// FETCH BYTE_ARRAY
-			ByteArray &data = (ByteArray&)parameter->referValue<ByteArray>();
-			data.assign(size, NULL);
+			std::shared_ptr<Invoke> invoke(new Invoke("_Offer_encoding"));
+			if (binary == true)
+				invoke->emplace_back(new InvokeParameter("", "string", InvokeCodec::NAME()));
+			if (compression == true)
+				invoke->emplace_back(new InvokeParameter("", "string", COMPRESSION_NAME()));
 
-			// READ CONTENT
-			listen_data(data);
+			sendData(invoke);
 		};
 
-		template <class Container>
-		void listen_data(Container &data)
+		/**
+		 * Handle messages for encoding negotiation.
+		 * 
+		 * @param invoke An {@link Invoke} message received from remote system.
+		 * @return Whether the *invoke* was a negotiation message, which must not be shifted to the listener.
+		 */
+		auto handle_negotiation(std::shared_ptr<Invoke> invoke) -> bool
 		{
-			size_t completed = 0;
+			const std::string &name = invoke->getListener();
+			if (name.empty() == true || name.front() != '_')
+				return false;
 
-			while (completed < data.size())
+			if (name == "_Offer_encoding")
 			{
-				size_t piece_size = socket->read_some(boost::asio::buffer((unsigned char*)data.data() + completed, data.size() - completed));
-				completed += piece_size;
+				std::shared_ptr<Invoke> reply(new Invoke("_Accept_encoding"));
+				for (size_t i = 0; i < invoke->size(); i++)
+				{
+					const std::string &encoding = invoke->at(i)->getValue<std::string>();
+					if (encoding == InvokeCodec::NAME() || encoding == COMPRESSION_NAME())
+						reply->emplace_back(new InvokeParameter("", "string", encoding));
+				}
+
+				if (reply->empty() == false)
+				{
+					// REPLY BY XML, THEN SWITCH
+					sendData(reply);
+					accept_encodings(*reply);
+				}
+				return true;
+			}
+			else if (name == "_Accept_encoding")
+			{
+				accept_encodings(*invoke);
+				return true;
 			}
+			return false;
 		};
 
-		/* ---------------------------------------------------------
-			SEND
-		--------------------------------------------------------- */
-		template <class Container>
-		void send_data(const Container &data)
+		/**
+		 * Handle a chunk of a received {@link ByteStream}.
+		 * 
+		 * A chunk is an {@link Invoke} message of the listener ```_Stream_chunk```, with id of the stream and content 
+		 * of the chunk as a *ByteArray* parameter. An empty chunk is end of the stream. A chunk of an unknown stream is 
+		 * discarded.
+		 * 
+		 * @param invoke An {@link Invoke} message received from remote system.
+		 * @return Whether the *invoke* was a chunk, which must not be shifted to the listener.
+		 */
+		auto handle_stream(std::shared_ptr<Invoke> invoke) -> bool
 		{
-			ByteArray header;
-			header.writeReversely((unsigned long long)data.size());
+			if (invoke->getListener() != STREAM_CHUNK())
+				return false;
+			else if (invoke->size() != 2 || invoke->at(1)->getTypeCode() != InvokeParameter::BYTE_ARRAY)
+				throw std::domain_error("malformed chunk of a stream has delivered.");
 
-			socket->write_some(boost::asio::buffer(header));
-			socket->write_some(boost::asio::buffer(data));
-		};
-	};
+			auto it = binary_streams.find(invoke->front()->getValue<size_t>());
+			if (it == binary_streams.end())
+				return true;
+
+			const ByteArray &chunk = invoke->at(1)->referValue<ByteArray>();
+			if (chunk.empty() == false)
+				it->second->write(chunk.data(), chunk.size());
+			else
+			{
+				// END OF THE STREAM
+				std::shared_ptr<ByteStream> stream = it->second;
+				binary_streams.erase(it);
+
+				stream->close();
+			}
+			return true;
+		};
+
+		/**
+		 * Handle a reply of a request sent by {@link call call()}, or ID of a request.
+		 * 
+		 * ID of a request is taken out of its parameters, to be found by {@link sendReply sendReply()}.
+		 * 
+		 * @param invoke An {@link Invoke} message received from remote system.
+		 * @return Whether the *invoke* was a reply, which must not be shifted to the listener.
+		 */
+		auto handle_call(std::shared_ptr<Invoke> invoke) -> bool
+		{
+			if (invoke->empty() == true)
+				return false;
+			else if (invoke->back()->getName() == PendingCalls::CALL_UID())
+			{
+				invoke->call_uid = invoke->back()->getValue<size_t>();
+				invoke->pop_back();
+
+				return false;
+			}
+			else if (invoke->back()->getName() != PendingCalls::REPLY_UID())
+				return false;
+
+			// A REPLY TIMED OUT IS DROPPED
+			size_t uid = invoke->back()->getValue<size_t>();
+			invoke->pop_back();
+
+			pending_calls->resolve(uid, invoke);
+			return true;
+		};
+
+		/**
+		 * Handle a message of a {@link Channel}.
+		 * 
+		 * A message of a channel not opened is discarded.
+		 * 
+		 * @param invoke An {@link Invoke} message received from remote system.
+		 * @return Whether the *invoke* belonged to a {@link Channel}, which must not be shifted to the listener.
+		 */
+		auto handle_channel(std::shared_ptr<Invoke> invoke) -> bool
+		{
+			size_t id = pop_channel(*invoke);
+			if (id == 0)
+				return false;
+			else if (handle_call(invoke) == true)
+				return true;
+
+			std::shared_ptr<IProtocol> channel;
+			{
+				std::unique_lock<std::mutex> uk(channels_mutex);
+
+				auto it = channels.find(id);
+				if (it != channels.end())
+					channel = it->second.lock();
+			}
+
+			if (channel != nullptr)
+				channel->replyData(invoke);
+			return true;
+		};
+
+		/**
+		 * Handle a query of the {@link Metrics}.
+		 * 
+		 * Replies the {@link Metrics} of this {@link Communicator}, with those of its listener as a child named 
+		 * ```listener```, if the listener has.
+		 * 
+		 * @param invoke An {@link Invoke} message received from remote system.
+		 * @return Whether the *invoke* was a query, which must not be shifted to the listener.
+		 */
+		auto handle_metrics(std::shared_ptr<Invoke> invoke) -> bool
+		{
+			if (invoke->getListener() != Metrics::QUERY_LISTENER())
+				return false;
+
+			std::shared_ptr<library::XML> xml = metrics.toXML();
+
+			IListener *i_listener = dynamic_cast<IListener*>(listener);
+			const Metrics *listener_metrics = (i_listener != nullptr) ? i_listener->_Get_metrics() : nullptr;
+
+			if (listener_metrics != nullptr)
+				xml->push_back(listener_metrics->toXML("listener"));
+
+			std::shared_ptr<Invoke> reply(new Invoke(Metrics::REPORT_LISTENER()));
+			reply->emplace_back(new InvokeParameter("", xml));
+
+			sendReply(*invoke, reply);
+			return true;
+		};
+
+	private:
+		static auto COMPRESSION_NAME() -> std::string
+		{
+			return "zlib";
+		};
+
+		/* ---------------------------------------------------------
+			CHANNELS
+		--------------------------------------------------------- */
+		static auto CHANNEL_ID() -> const std::string&
+		{
+			static const std::string name = "_Channel_id";
+			return name;
+		};
+
+		void open_channel(size_t id, std::weak_ptr<IProtocol> channel)
+		{
+			std::unique_lock<std::mutex> uk(channels_mutex);
+
+			auto it = channels.find(id);
+			if (it != channels.end() && it->second.expired() == false)
+				throw std::invalid_argument("Channel #" + std::to_string(id) + " is opened already.");
+
+			channels[id] = channel;
+		};
+
+		void close_channel(size_t id)
+		{
+			std::unique_lock<std::mutex> uk(channels_mutex);
+
+			// NOT A NEWER CHANNEL OF THE SAME ID
+			auto it = channels.find(id);
+			if (it != channels.end() && it->second.expired() == true)
+				channels.erase(it);
+		};
+
+		static void push_channel(Invoke &invoke, size_t id)
+		{
+			invoke.push_back(InvokePool::get().createParameter(CHANNEL_ID(), id));
+		};
+
+		static auto pop_channel(Invoke &invoke) -> size_t
+		{
+			if (invoke.empty() == true || invoke.back()->getName() != CHANNEL_ID())
+				return 0;
+
+			size_t id = invoke.back()->getValue<size_t>();
+			invoke.pop_back();
+
+			return id;
+		};
+
+		void accept_encodings(const Invoke &invoke)
+		{
+			for (size_t i = 0; i < invoke.size(); i++)
+			{
+				const std::string &encoding = invoke.at(i)->getValue<std::string>();
+
+				if (encoding == InvokeCodec::NAME())
+					binary_encoding = true;
+				else if (encoding == COMPRESSION_NAME())
+					compression = true;
+			}
+		};
+
+	protected:
+		/**
+		 * Construct an {@link Invoke} message from a received frame.
+		 * 
+		 * @param data Content of a frame, following either the XML or the binary encoding.
+		 */
+		static auto decode_invoke(const std::string &data) -> std::shared_ptr<Invoke>
+		{
+			return decode_invoke((const unsigned char*)data.data(), data.size());
+		};
+
+		/**
+		 * Construct an {@link Invoke} message from a received frame.
+		 * 
+		 * @param data Content of a frame, following either the XML or the binary encoding.
+		 * @param size Size of the content.
+		 */
+		static auto decode_invoke(const unsigned char *data, size_t size) -> std::shared_ptr<Invoke>
+		{
+			if (InvokeCodec::isBinary(data, size) == true)
+				return InvokeCodec::decode(data, size);
+
+			std::shared_ptr<Invoke> invoke = InvokePool::get().createInvoke();
+			invoke->construct(std::make_shared<library::XML>(std::string((const char*)data, size)));
+
+			return invoke;
+		};
+
+		/* =========================================================
+			SOCKET I/O
+				- READ
+				- WRITE
+		============================================================
+			READ
+		--------------------------------------------------------- */
+		virtual void listen_message()
+		{
+			std::exception_ptr error;
+
+			while (true)
+			{
+				try
+				{
+					// PARSE BUFFERED FRAMES
+					size_t remainder;
+					if (handle_buffered_frames(remainder) == false)
+						break;
+
+					// READ MORE
+					if (remainder != 0)
+					{
+						boost::asio::read(*socket, boost::asio::buffer(large_frame, remainder));
+						bytes_in->fetch_add(remainder, std::memory_order_relaxed);
+
+						handle_large_frame();
+					}
+					else
+					{
+						size_t size = socket->read_some(receive_buffer.prepare());
+						bytes_in->fetch_add(size, std::memory_order_relaxed);
+
+						receive_buffer.commit(size);
+					}
+				}
+				catch (...)
+				{
+					error = std::current_exception();
+					break;
+				}
+			}
+			handle_close(error);
+		};
+
+		void listen_message_async()
+		{
+			dispatch_async([]() {});
+		};
+
+		/**
+		 * Handle frames buffered in the {@link receive_buffer}.
+		 * 
+		 * Handles as many complete frames as are buffered. A frame larger than the {@link receive_buffer} is not 
+		 * buffered; its buffered part is moved to its destination, and the remainder is to be read directly into the 
+		 * {@link large_frame}, then {@link handle_large_frame handled}.
+		 * 
+		 * @param remainder Number of bytes to read into the {@link large_frame}, or zero if more bytes have to be 
+		 *					buffered.
+		 * @return Whether to keep listening.
+		 */
+		virtual auto handle_buffered_frames(size_t &remainder) -> bool
+		{
+			remainder = 0;
+
+			while (receive_buffer.size() >= 8)
+			{
+				unsigned long long header = decode_size(receive_buffer.data());
+				bool compressed = (header & COMPRESSED) != 0;
+
+				size_t content_size = (size_t)(header & ~COMPRESSED);
+				size_t buffered = receive_buffer.size() - 8;
+
+				if (content_size > max_frame_size)
+					throw std::length_error("frame exceeds the maximum size.");
+
+				if (buffered >= content_size)
+				{
+					// COMPLETE FRAME
+					receive_buffer.consume(8);
+					const unsigned char *data = receive_buffer.data();
+
+					if (compressed == true)
+					{
+						ByteArray frame = ByteArray::decompress(data, content_size, max_frame_size);
+						receive_buffer.consume(content_size);
+
+						handle_frame(std::move(frame));
+					}
+					else
+					{
+						handle_frame(data, content_size);
+						receive_buffer.consume(content_size);
+					}
+				}
+				else if (8 + content_size <= receive_buffer.capacity())
+					break; // WAIT FOR THE REST
+				else
+				{
+					// LARGE FRAME
+					receive_buffer.consume(8);
+					large_compressed = compressed;
+
+					if (compressed == true)
+					{
+						compressed_frame.clear();
+						compressed_frame.resizeUninitialized(content_size);
+						large_frame = compressed_frame.data();
+					}
+					else if (binary_invoke == nullptr)
+					{
+						content.assign(content_size, (char)NULL);
+						large_frame = (unsigned char*)&content[0];
+					}
+					else
+					{
+						ByteArray &byte_array = (ByteArray&)binary_parameters.front()->referValue<ByteArray>();
+						byte_array.clear();
+						byte_array.resizeUninitialized(content_size);
+						large_frame = byte_array.data();
+					}
+
+					std::memcpy(large_frame, receive_buffer.data(), buffered);
+					receive_buffer.consume(buffered);
+
+					large_frame += buffered;
+					remainder = content_size - buffered;
+					break;
+				}
+			}
+			return true;
+		};
+
+		/**
+		 * Handle a large frame whose remainder has been read into the {@link large_frame}.
+		 */
+		virtual void handle_large_frame()
+		{
+			if (large_compressed == true)
+			{
+				ByteArray frame;
+				frame.swap(compressed_frame);
+
+				handle_frame(ByteArray::decompress(frame.data(), frame.size(), max_frame_size));
+			}
+			else if (binary_invoke == nullptr)
+			{
+				std::shared_ptr<Invoke> invoke = decode_invoke(content);
+				content.clear();
+				content.shrink_to_fit();
+
+				handle_invoke(invoke);
+			}
+			else
+				handle_binary();
+		};
+
+		/**
+		 * Handle content of a complete frame.
+		 * 
+		 * The content is an {@link Invoke} message or content of the front *ByteArray* parameter, by the state.
+		 * 
+		 * @param data Content of the frame.
+		 * @param size Size of the content.
+		 */
+		void handle_frame(const unsigned char *data, size_t size)
+		{
+			if (binary_invoke == nullptr)
+				handle_invoke(decode_invoke(data, size));
+			else
+			{
+				ByteArray &byte_array = (ByteArray&)binary_parameters.front()->referValue<ByteArray>();
+				byte_array.assign(data, data + size);
+
+				handle_binary();
+			}
+		};
+
+		/**
+		 * Handle content of a complete frame, which can be moved to a *ByteArray* parameter.
+		 * 
+		 * @param data Content of the frame.
+		 */
+		void handle_frame(ByteArray &&data)
+		{
+			if (binary_invoke != nullptr)
+			{
+				ByteArray &byte_array = (ByteArray&)binary_parameters.front()->referValue<ByteArray>();
+				byte_array = std::move(data);
+
+				handle_binary();
+			}
+			else
+				handle_frame(data.data(), data.size());
+		};
+
+		/**
+		 * Handle an {@link Invoke} message constructed from a frame.
+		 * 
+		 * If the {@link Invoke} message has *ByteArray* parameters, the message is held until contents of the parameters
+		 * arrive. Otherwise, the message is shifted to {@link replyData replyData()} directly.
+		 * 
+		 * {@link ByteStream} parameters are registered by their ids, in order of the wire, for their chunks following 
+		 * the message. The listener attaches sinks to them in {@link replyData replyData()}, before any chunk arrives.
+		 * 
+		 * @param invoke An {@link Invoke} message received.
+		 */
+		void handle_invoke(std::shared_ptr<Invoke> invoke)
+		{
+			for (size_t i = 0; i < invoke->size(); i++)
+			{
+				std::shared_ptr<InvokeParameter> &parameter = invoke->at(i);
+				if (parameter->getTypeCode() == InvokeParameter::BYTE_STREAM)
+				{
+					// A NULL STREAM HAS NO CHUNK
+					std::shared_ptr<ByteStream> stream = parameter->getValue<std::shared_ptr<ByteStream>>();
+					if (stream != nullptr)
+						binary_streams[received_streams++] = stream;
+					continue;
+				}
+				else if (parameter->getTypeCode() != InvokeParameter::BYTE_ARRAY)
+					continue;
+
+				if (binary_invoke == nullptr)
+					binary_invoke = invoke;
+				binary_parameters.push(parameter);
+			}
+
+			// NO BINARY, THEN REPLY DIRECTLY
+			if (binary_invoke == nullptr)
+				reply_invoke(invoke);
+		};
+
+		/**
+		 * Handle completion of the front binary parameter's content.
+		 */
+		void handle_binary()
+		{
+			binary_parameters.pop();
+			if (binary_parameters.empty() == false)
+				return;
+
+			// NO BINARY PARAMETER LEFT, THEN REPLY
+			std::shared_ptr<Invoke> invoke = binary_invoke;
+			binary_invoke = nullptr;
+
+			reply_invoke(invoke);
+		};
+
+		/**
+		 * Shift a received {@link Invoke} message to {@link replyData replyData()}, measuring time of the handler.
+		 * 
+		 * @param invoke An {@link Invoke} message received.
+		 */
+		void reply_invoke(std::shared_ptr<Invoke> invoke)
+		{
+			messages_in->fetch_add(1, std::memory_order_relaxed);
+
+			// BEFORE THE HANDLER, WHICH MAY MODIFY THE INVOKE
+			library::Histogram *listener_time = find_listener_time(invoke->getListener());
+
+			auto first = std::chrono::steady_clock::now();
+			this->replyData(invoke);
+
+			long long elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - first).count();
+			handler_time->record(elapsed);
+			if (listener_time != nullptr)
+				listener_time->record(elapsed);
+		};
+
+	private:
+		auto find_listener_time(const std::string &listener) -> library::Histogram*
+		{
+			// NEITHER BUILDING THE NAME NOR LOCKING THE METRICS, BUT THE FIRST TIME
+			auto it = listener_times.find(listener);
+			if (it != listener_times.end())
+				return it->second;
+			else if (listener_times.size() >= MAX_HANDLER_LISTENERS)
+				return nullptr;
+
+			library::Histogram *histogram = &metrics.histogram("handler." + listener);
+			listener_times.emplace(listener, histogram);
+
+			return histogram;
+		};
+
+		/**
+		 * Run a handler and parse buffered frames in the asynchronous mode, then read more.
+		 * 
+		 * @param handler A handler of the last read. An exception from it closes the connection, as the blocking mode does.
+		 */
+		void dispatch_async(std::function<void()> handler)
+		{
+			size_t remainder;
+			try
+			{
+				handler();
+
+				// PARSE BUFFERED FRAMES
+				if (handle_buffered_frames(remainder) == false)
+				{
+					handle_close();
+					return;
+				}
+			}
+			catch (...)
+			{
+				handle_close(std::current_exception());
+				return;
+			}
+
+			// READ MORE
+			std::shared_ptr<Communicator> self = shared_from_this();
+
+			if (remainder != 0)
+				boost::asio::async_read(*socket, boost::asio::buffer(large_frame, remainder), strand->wrap([this, self](const boost::system::error_code &error, size_t size)
+				{
+					bytes_in->fetch_add(size, std::memory_order_relaxed);
+
+					if (error)
+						handle_close();
+					else
+						dispatch_async([this]()
+						{
+							handle_large_frame();
+						});
+				}));
+			else
+				socket->async_read_some(receive_buffer.prepare(), strand->wrap([this, self](const boost::system::error_code &error, size_t size)
+				{
+					bytes_in->fetch_add(size, std::memory_order_relaxed);
+
+					if (error)
+						handle_close();
+					else
+						dispatch_async([this, size]()
+						{
+							receive_buffer.commit(size);
+						});
+				}));
+		};
+
+		static auto decode_size(const unsigned char *size_header) -> unsigned long long
+		{
+			unsigned long long size = 0;
+			for (size_t c = 0; c < 8; c++)
+				size = (size << 8) | size_header[c];
+
+			return size;
+		};
+
+		/* ---------------------------------------------------------
+			SEND
+		--------------------------------------------------------- */
+		// THE HIGHEST BIT OF A SIZE HEADER
+		static const unsigned long long COMPRESSED = 1ull << 63;
+
+		void pack_frame(OutboundMessage &message, std::string &&data)
+		{
+			if (pack_compressed_frame(message, (const unsigned char*)data.data(), data.size()) == true)
+				return;
+
+			message.push(frame_header(data.size()));
+			message.push(std::move(data));
+		};
+
+		void pack_frame(OutboundMessage &message, ByteArray &&data)
+		{
+			if (pack_compressed_frame(message, data.data(), data.size()) == true)
+				return;
+
+			message.push(frame_header(data.size()));
+			message.push(std::move(data));
+		};
+
+		void pack_frame(OutboundMessage &message, const ByteArray &data)
+		{
+			if (pack_compressed_frame(message, data.data(), data.size()) == true)
+				return;
+
+			message.push(frame_header(data.size()));
+			message.refer(data.data(), data.size());
+		};
+
+		auto pack_compressed_frame(OutboundMessage &message, const unsigned char *data, size_t size) -> bool
+		{
+			if (compression == false || size < compression_threshold)
+				return false;
+
+			ByteArray compressed = ByteArray::compress(data, size, Z_BEST_SPEED);
+			if (compressed.size() >= size)
+				return false; // INCOMPRESSIBLE
+
+			message.push(frame_header(compressed.size(), true));
+			message.push(std::move(compressed));
+
+			return true;
+		};
+
+		static auto frame_header(size_t size, bool compressed = false) -> ByteArray
+		{
+			unsigned long long header = size;
+			if (compressed == true)
+				header |= COMPRESSED;
+
+			ByteArray header_bytes;
+			header_bytes.writeReversely(header);
+
+			return header_bytes;
+		};
+
+	protected:
+		/**
+		 * Write the queued messages, by the elected writer.
+		 * 
+		 * In the blocking mode, the calling thread writes the queued messages until the queue gets idle. In the 
+		 * asynchronous mode, the I/O service writes them instead.
+		 */
+		void write_messages()
+		{
+			if (strand == nullptr)
+				write_queue();
+			else
+			{
+				std::shared_ptr<Communicator> self = shared_from_this();
+				strand->post([this, self]()
+				{
+					write_queue_async();
+				});
+			}
+		};
+
+	private:
+		void write_queue()
+		{
+			std::vector<std::shared_ptr<OutboundMessage>> messages;
+			size_t count;
+			size_t attempt = 0;
+
+			Communicator *previous = writing();
+			writing() = this;
+
+			do
+			{
+				messages.clear();
+
+				count = take_messages(messages);
+				if (count == 0)
+				{
+					// A PUSH IS ON THE WAY, WAIT FOR IT WITH A BACKOFF
+					if (attempt < 64)
+						std::this_thread::yield();
+					else
+						std::this_thread::sleep_for(push_backoff(attempt - 64));
+
+					attempt++;
+					continue;
+				}
+				attempt = 0;
+
+				if (messages.empty() == false) // ALL MAY HAVE BEEN DROPPED
+				{
+					std::shared_ptr<OutboundMessage> batch = merge_messages(messages);
+					boost::system::error_code error;
+
+					bytes_out->fetch_add(boost::asio::write(*socket, batch->getBuffers(), error), std::memory_order_relaxed);
+					if (!error)
+						messages_out->fetch_add(count_invokes(messages), std::memory_order_relaxed);
+
+					queued_messages -= messages.size();
+					release_window(batch->size());
+					batch->complete(error);
+				}
+			} 
+			while (send_queue.complete(count) == true);
+
+			writing() = previous;
+		};
+
+		void write_queue_async(size_t attempt = 0)
+		{
+			std::shared_ptr<Communicator> self = shared_from_this();
+
+			std::vector<std::shared_ptr<OutboundMessage>> messages;
+
+			size_t count = take_messages(messages);
+			if (count == 0)
+			{
+				// A PUSH IS ON THE WAY, WAIT FOR IT WITH A BACKOFF
+				if (attempt < 64)
+					strand->post([this, self, attempt]()
+					{
+						write_queue_async(attempt + 1);
+					});
+				else
+				{
+					std::shared_ptr<boost::asio::steady_timer> timer(new boost::asio::steady_timer(service_pool->getService()));
+					timer->expires_after(push_backoff(attempt - 64));
+					timer->async_wait(strand->wrap([this, self, timer, attempt](const boost::system::error_code &)
+					{
+						write_queue_async(attempt + 1);
+					}));
+				}
+				return;
+			}
+			else if (messages.empty() == true)
+			{
+				// ALL HAVE BEEN DROPPED
+				if (send_queue.complete(count) == true)
+					write_queue_async();
+				return;
+			}
+
+			std::shared_ptr<OutboundMessage> batch = merge_messages(messages);
+			size_t written = messages.size();
+			size_t invokes = count_invokes(messages);
+
+			boost::asio::async_write(*socket, batch->getBuffers(), strand->wrap([this, self, batch, count, written, invokes](const boost::system::error_code &error, size_t size)
+			{
+				bytes_out->fetch_add(size, std::memory_order_relaxed);
+				if (!error)
+					messages_out->fetch_add(invokes, std::memory_order_relaxed);
+
+				queued_messages -= written;
+				release_window(batch->size());
+				batch->complete(error);
+
+				if (send_queue.complete(count) == true)
+					write_queue_async();
+			}));
+		};
+
+		/* ---------------------------------------------------------
+			STREAMS
+		--------------------------------------------------------- */
+		static auto STREAM_CHUNK() -> const std::string&
+		{
+			static const std::string name = "_Stream_chunk";
+			return name;
+		};
+
+		/**
+		 * Get a callback of an {@link Invoke} message, which starts its {@link ByteStream} parameters after the message
+		 * has been written, then calls the *callback* after all of them have been written.
+		 */
+		auto stream_callback(std::shared_ptr<Invoke> invoke, std::function<void(const boost::system::error_code&)> callback) -> std::function<void(const boost::system::error_code&)>
+		{
+			std::vector<std::shared_ptr<ByteStream>> streams;
+			for (size_t i = 0; i < invoke->size(); i++)
+			{
+				if (invoke->at(i)->getTypeCode() != InvokeParameter::BYTE_STREAM)
+					continue;
+
+				// A NULL STREAM, TYPE-ONLY, HAS NO CHUNK
+				std::shared_ptr<ByteStream> stream = invoke->at(i)->getValue<std::shared_ptr<ByteStream>>();
+				if (stream != nullptr)
+					streams.push_back(stream);
+			}
+
+			if (streams.empty() == true)
+				return callback;
+
+			return [this, streams, callback](const boost::system::error_code &error)
+			{
+				if (error)
+				{
+					if (callback != nullptr)
+						callback(error);
+					return;
+				}
+
+				// COMPLETIONS ARE SERIALIZED BY THE WRITER, THUS NO LOCK
+				std::shared_ptr<size_t> remained(new size_t(streams.size()));
+				std::shared_ptr<boost::system::error_code> result(new boost::system::error_code());
+
+				std::function<void(const boost::system::error_code&)> handler = [remained, result, callback](const boost::system::error_code &error)
+				{
+					if (error && !*result)
+						*result = error;
+					if (--*remained == 0 && callback != nullptr)
+						callback(*result);
+				};
+
+				// IDS BY ORDER OF THE WIRE, AS THE RECEIVER COUNTS
+				for (size_t i = 0; i < streams.size(); i++)
+					write_stream(streams[i], sent_streams++, handler);
+			};
+		};
+
+		/**
+		 * Send next chunk of a {@link ByteStream}, as a message of its own.
+		 * 
+		 * A chunk is read from the {@link ByteStream} only after the previous one has been written, from the writer's 
+		 * thread. Thus other messages are written between the chunks.
+		 */
+		void write_stream(std::shared_ptr<ByteStream> stream, size_t id, std::function<void(const boost::system::error_code&)> handler)
+		{
+			ByteArray chunk;
+			chunk.resizeUninitialized(ByteStream::CHUNK_SIZE);
+
+			size_t size;
+			try
+			{
+				size = stream->read(chunk.data(), chunk.size());
+			}
+			catch (...)
+			{
+				// A TRUNCATED STREAM CAN'T BE TERMINATED, THEN CLOSE
+				close();
+
+				handler(boost::system::errc::make_error_code(boost::system::errc::io_error));
+				return;
+			}
+			chunk.resize(size);
+
+			std::shared_ptr<Invoke> invoke = InvokePool::get().createInvoke(STREAM_CHUNK());
+			invoke->push_back(InvokePool::get().createParameter("", id));
+			invoke->emplace_back(new InvokeParameter("", std::move(chunk)));
+
+			// EMPTY CHUNK, END OF THE STREAM
+			sendData(invoke, [this, stream, id, size, handler](const boost::system::error_code &error)
+			{
+				if (error || size == 0)
+					handler(error);
+				else
+					write_stream(stream, id, handler);
+			});
+		};
+
+		/* ---------------------------------------------------------
+			SEND WINDOW
+		--------------------------------------------------------- */
+		// THE COMMUNICATOR WHICH THE CURRENT THREAD IS WRITING, IN THE BLOCKING MODE
+		static auto writing() -> Communicator*&
+		{
+			thread_local Communicator *communicator = nullptr;
+			return communicator;
+		};
+
+		auto push_message(std::shared_ptr<OutboundMessage> message) -> bool
+		{
+			if (send_window.acquire(message->size()) == true)
+				high_watermark_reached = true;
+
+			queued_messages++;
+			return send_queue.push(message);
+		};
+
+		void handle_high_watermark()
+		{
+			// OUT OF THE PACKING LOCKS
+			if (high_watermark_reached.exchange(false) == false)
+				return;
+
+			std::function<void(size_t)> handler = onHighWatermark;
+			if (handler != nullptr)
+				handler(send_window.size());
+
+			if (send_window.getPolicy() == SendWindow::DISCONNECT)
+				close();
+		};
+
+		void release_window(size_t size)
+		{
+			if (send_window.release(size) == false)
+				return;
+
+			std::function<void(size_t)> handler = onLowWatermark;
+			if (handler != nullptr)
+				handler(send_window.size());
+		};
+
+		auto take_messages(std::vector<std::shared_ptr<OutboundMessage>> &messages) -> size_t
+		{
+			std::vector<std::shared_ptr<OutboundMessage>> dropped;
+			size_t count;
+			{
+				// THE BACKLOG PRECEDES MESSAGES STILL IN THE QUEUE
+				std::unique_lock<std::mutex> uk(backlog_mutex);
+
+				messages.swap(backlog);
+				count = backlog_count + pop_messages(messages);
+				backlog_count = 0;
+
+				shed_messages(messages, dropped);
+			}
+			notify_dropped(dropped);
+
+			return count;
+		};
+
+		void shed_backlog()
+		{
+			// THE WRITER MAY BE WAITING FOR THE SLOW CONSUMER, WITHOUT POPPING
+			if (send_window.isShedding() == false)
+				return;
+
+			std::vector<std::shared_ptr<OutboundMessage>> dropped;
+			{
+				std::unique_lock<std::mutex> uk(backlog_mutex);
+
+				backlog_count += pop_messages(backlog);
+				shed_messages(backlog, dropped);
+			}
+			notify_dropped(dropped);
+		};
+
+		auto pop_messages(std::vector<std::shared_ptr<OutboundMessage>> &messages) -> size_t
+		{
+			size_t size = messages.size();
+			send_queue.pop(messages);
+
+			return messages.size() - size;
+		};
+
+		// A PUSH ELECTING THE WRITER IS LINKED SHORTLY, UNLESS ITS THREAD HAS BEEN PREEMPTED
+		static auto push_backoff(size_t attempt) -> std::chrono::microseconds
+		{
+			return std::chrono::microseconds(std::min<size_t>(1000, (size_t)10 << std::min<size_t>(attempt, 7)));
+		};
+
+		// CONTROL FRAMES ARE NOT COUNTED AS MESSAGES
+		static auto count_invokes(const std::vector<std::shared_ptr<OutboundMessage>> &messages) -> size_t
+		{
+			size_t count = 0;
+			for (auto it = messages.begin(); it != messages.end(); it++)
+				if ((*it)->getInvoke() != nullptr)
+					count++;
+
+			return count;
+		};
+
+		void shed_messages(std::vector<std::shared_ptr<OutboundMessage>> &messages, std::vector<std::shared_ptr<OutboundMessage>> &dropped)
+		{
+			if (send_window.isShedding() == false)
+				return;
+
+			std::vector<std::shared_ptr<OutboundMessage>> kept;
+			kept.reserve(messages.size());
+
+			if (send_window.getPolicy() == SendWindow::COALESCE)
+			{
+				// THE LATEST OF EACH LISTENER SURVIVES
+				std::unordered_set<std::string> listeners;
+				for (size_t i = messages.size(); i-- > 0; )
+				{
+					std::shared_ptr<OutboundMessage> &message = messages[i];
+					if (can_drop(*message) == false || listeners.insert(coalescing_key(*message->getInvoke())).second == true)
+						kept.push_back(std::move(message));
+					else
+						dropped.push_back(std::move(message));
+				}
+				std::reverse(kept.begin(), kept.end());
+			}
+			else
+			{
+				// THE OLDEST ARE DROPPED, TO THE LOW WATERMARK
+				size_t bytes = send_window.size();
+				size_t low_watermark = send_window.getLowWatermark();
+
+				for (size_t i = 0; i < messages.size(); i++)
+				{
+					std::shared_ptr<OutboundMessage> &message = messages[i];
+					if (bytes > low_watermark && can_drop(*message) == true)
+					{
+						bytes -= std::min(bytes, message->size());
+						dropped.push_back(std::move(message));
+					}
+					else
+						kept.push_back(std::move(message));
+				}
+			}
+			messages.swap(kept);
+		};
+
+		auto can_drop(const OutboundMessage &message) const -> bool
+		{
+			// NEITHER A CONTROL FRAME NOR A CHUNK OF STREAM, WHICH WOULD TRUNCATE THE STREAM
+			return message.getInvoke() != nullptr && message.getInvoke()->getListener() != STREAM_CHUNK() 
+				&& is_droppable(message) == true;
+		};
+
+		void notify_dropped(const std::vector<std::shared_ptr<OutboundMessage>> &dropped)
+		{
+			// OUT OF THE LOCK
+			queued_messages -= dropped.size();
+			messages_dropped->fetch_add(dropped.size(), std::memory_order_relaxed);
+
+			for (size_t i = 0; i < dropped.size(); i++)
+			{
+				release_window(dropped[i]->size());
+				dropped[i]->complete(boost::asio::error::no_buffer_space);
+			}
+		};
+
+		static auto coalescing_key(const Invoke &invoke) -> std::string
+		{
+			// LISTENERS OF DIFFERENT CHANNELS ARE DIFFERENT
+			if (invoke.empty() == false && invoke.back()->getName() == CHANNEL_ID())
+				return invoke.getListener() + '#' + invoke.back()->getValue<std::string>();
+			else
+				return invoke.getListener();
+		};
+
+		/* ---------------------------------------------------------
+			BATCH
+		--------------------------------------------------------- */
+		static auto merge_messages(const std::vector<std::shared_ptr<OutboundMessage>> &messages) -> std::shared_ptr<OutboundMessage>
+		{
+			if (messages.size() == 1)
+				return messages.front();
+
+			std::shared_ptr<OutboundMessage> batch(new OutboundMessage());
+			for (auto it = messages.begin(); it != messages.end(); it++)
+				batch->append(*it);
+
+			return batch;
+		};
+	};
+};
 };
-};
\ No newline at end of file
@@ -0,0 +1,206 @@
+#pragma once
+#include <samchon/API.hpp>
+
+/* -------------------------------------------------------------------------
+	C++20 COROUTINES, IF THE COMPILER SUPPORTS
+------------------------------------------------------------------------- */
+#if defined(__cpp_impl_coroutine) && defined(__has_include)
+#	if __has_include(<coroutine>)
+#		define SAMCHON_COROUTINE 1
+#	endif
+#endif
+
+#ifdef SAMCHON_COROUTINE
+#include <coroutine>
+#include <exception>
+#include <functional>
+#include <optional>
+#include <utility>
+
+namespace samchon
+{
+namespace protocol
+{
+	/**
+	 * An asynchronous operation to be awaited by ```co_await```.
+	 *
+	 * The {@link Awaitable} adapts a callback-based operation, like {@link Communicator.call Communicator.call()}, to
+	 * C++20 coroutines. The operation starts when it is awaited, and the awaiting coroutine is suspended without
+	 * blocking its thread. When the operation completes, the coroutine is resumed in the thread completing it, like a
+	 * thread receiving the reply; then ```co_await``` returns the result, or throws the error.
+	 *
+	 * @code
+	 * protocol::Task request(std::shared_ptr<protocol::Communicator> communicator)
+	 * {
+	 *	   std::shared_ptr<protocol::Invoke> reply = co_await communicator->asyncCall(std::make_shared<protocol::Invoke>("query"));
+	 *	   ...
+	 * }
+	 * @endcode
+	 *
+	 * @tparam T Type of the result.
+	 * @see {@link Task}
+	 * @author Jeongho Nam <http://samchon.org>
+	 */
+	template <typename T>
+	class Awaitable
+	{
+	public:
+		/**
+		 * A function called with the result, or with an error.
+		 */
+		typedef std::function<void(T, std::exception_ptr)> Handler;
+
+	private:
+		std::function<void(Handler)> starter_;
+
+		std::optional<T> result_;
+		std::exception_ptr error_;
+
+	public:
+		/**
+		 * Construct from a starter.
+		 *
+		 * @param starter A function starting the operation, which calls the handler when the operation completes.
+		 */
+		Awaitable(std::function<void(Handler)> starter)
+			: starter_(std::move(starter))
+		{
+		};
+
+		auto await_ready() const noexcept -> bool
+		{
+			return false;
+		};
+
+		void await_suspend(std::coroutine_handle<> handle)
+		{
+			// THE HANDLER MAY RESUME BEFORE THE STARTER RETURNS; DON'T TOUCH THIS AFTER STARTING
+			std::function<void(Handler)> starter = std::move(starter_);
+			starter([this, handle](T result, std::exception_ptr error)
+			{
+				if (error != nullptr)
+					error_ = error;
+				else
+					result_.emplace(std::move(result));
+
+				handle.resume();
+			});
+		};
+
+		auto await_resume() -> T
+		{
+			if (error_ != nullptr)
+				std::rethrow_exception(error_);
+
+			return std::move(*result_);
+		};
+	};
+
+	/**
+	 * A detached coroutine.
+	 *
+	 * The {@link Task} is a return type of coroutines which are not awaited by others, like handlers of
+	 * {@link Invoke} messages. A coroutine returning {@link Task} doesn't run until it is {@link start started}, and
+	 * its frame is destroyed when it finishes. A {@link Task} never started is destroyed with its frame.
+	 *
+	 * As a detached ```std::thread```, an exception escaping from the coroutine terminates the program.
+	 *
+	 * @see {@link Awaitable}
+	 * @author Jeongho Nam <http://samchon.org>
+	 */
+	class Task
+	{
+	public:
+		struct promise_type
+		{
+			std::function<void()> on_complete;
+
+			auto get_return_object() -> Task
+			{
+				return Task(std::coroutine_handle<promise_type>::from_promise(*this));
+			};
+
+			auto initial_suspend() noexcept -> std::suspend_always
+			{
+				return {};
+			};
+
+			auto final_suspend() noexcept -> std::suspend_never
+			{
+				if (on_complete != nullptr)
+					on_complete();
+				return {};
+			};
+
+			void return_void()
+			{
+			};
+
+			void unhandled_exception()
+			{
+				std::terminate();
+			};
+		};
+
+	private:
+		std::coroutine_handle<promise_type> handle_;
+
+	public:
+		/* ---------------------------------------------------------
+			CONSTRUCTORS
+		--------------------------------------------------------- */
+		/**
+		 * Default Constructor, an empty {@link Task} without coroutine.
+		 */
+		Task()
+			: handle_(nullptr)
+		{
+		};
+
+		Task(Task &&obj) noexcept
+			: handle_(std::exchange(obj.handle_, nullptr))
+		{
+		};
+		Task(const Task &) = delete;
+
+		~Task()
+		{
+			if (handle_ != nullptr)
+				handle_.destroy();
+		};
+
+		/* ---------------------------------------------------------
+			ACCESSORS
+		--------------------------------------------------------- */
+		/**
+		 * Test whether the {@link Task} has a coroutine not started yet.
+		 */
+		auto valid() const -> bool
+		{
+			return handle_ != nullptr;
+		};
+
+		/**
+		 * Start the coroutine.
+		 *
+		 * The coroutine runs in the calling thread until its first suspension, then this method returns.
+		 *
+		 * @param on_complete A function called when the coroutine has finished, from the thread finishing it.
+		 */
+		void start(std::function<void()> on_complete = nullptr)
+		{
+			std::coroutine_handle<promise_type> handle = std::exchange(handle_, nullptr);
+
+			handle.promise().on_complete = std::move(on_complete);
+			handle.resume();
+		};
+
+	private:
+		explicit Task(std::coroutine_handle<promise_type> handle)
+			: handle_(handle)
+		{
+		};
+	};
+};
+};
+#endif
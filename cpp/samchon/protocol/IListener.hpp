@@ -8,6 +8,8 @@ namespace samchon
 namespace protocol
 {
 	class Communicator;
+	class Channel;
+	class Metrics;
 
 	/**
 	 * An interface for {@link Invoke} message chain.
@@ -29,9 +31,20 @@ namespace protocol
 	class IListener : public virtual IProtocol
 	{
 		friend class Communicator;
+		friend class Channel;
 
 	protected:
 		virtual void _Reply_data(std::shared_ptr<Invoke>) = 0;
+
+		/**
+		 * Metrics of the listener, reported with those of the {@link Communicator} to the remote system.
+		 *
+		 * @return The {@link Metrics}, ```nullptr``` if the listener has no metrics.
+		 */
+		virtual auto _Get_metrics() const -> const Metrics*
+		{
+			return nullptr;
+		};
 	};
 };
 };
\ No newline at end of file
@@ -0,0 +1,203 @@
+#pragma once
+#include <samchon/API.hpp>
+
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include <boost/asio.hpp>
+#include <samchon/protocol/Socket.hpp>
+
+#ifdef SAMCHON_IO_URING
+#	include <samchon/protocol/IOUringSocket.hpp>
+#endif
+
+namespace samchon
+{
+namespace protocol
+{
+	/**
+	 * A pool of threads running an I/O service.
+	 *
+	 * The {@link IOServicePool} is a reactor shared by {@link Server servers} and {@link Communicator communicators}
+	 * working in the asynchronous mode. Instead of dedicating a thread to each connection, all the connections
+	 * registered to an {@link IOServicePool} are driven by a fixed number of threads, which run the shared
+	 * ```boost::asio::io_service```.
+	 *
+	 * To use the asynchronous mode, create an {@link IOServicePool} and deliver it to {@link Server.setIOServicePool}
+	 * or {@link ServerConnector.setIOServicePool} before opening or connecting. Then,
+	 *
+	 * - {@link Server.open Server.open()} returns immediately after starting to accept clients.
+	 * - {@link ClientDriver.listen ClientDriver.listen()} and {@link ServerConnector.connect ServerConnector.connect()}
+	 *   return immediately after starting to listen messages. Use {@link Communicator.onClose} to be notified of
+	 *   disconnection.
+	 *
+	 * Replied {@link Invoke} messages are still shifted to {@link IProtocol.replyData IProtocol.replyData()} one by one,
+	 * in the order of arrival, for each connection. Note that a long running *replyData()* holds one of the threads;
+	 * hand over heavy jobs to your own worker.
+	 *
+	 * On Linux, TCP connections can be driven by io_uring instead of *epoll*, by {@link setIOUring setIOUring()}. Then
+	 * reads and writes are batched into a few system calls, which pays off when the system calls dominate, as on a
+	 * master with many busy connections. Handlers are still run by the threads of the pool. The io_uring is optional;
+	 * it's compiled only when ```SAMCHON_IO_URING``` has been defined, requiring headers of Linux 6.0 or later.
+	 *
+	 * @see {@link Server}, {@link Communicator}
+	 * @author Jeongho Nam <http://samchon.org>
+	 */
+	class IOServicePool
+	{
+	private:
+		// SHARED WITH THE THREADS, WHICH MAY OUTLIVE THE POOL
+		std::shared_ptr<boost::asio::io_service> service;
+		std::unique_ptr<boost::asio::io_service::work> work;
+
+		std::vector<std::thread> threads;
+
+#ifdef SAMCHON_IO_URING
+		std::vector<std::shared_ptr<IOUring>> rings;
+		std::atomic<size_t> ring_index;
+#endif
+
+	public:
+		/* ---------------------------------------------------------
+			CONSTRUCTORS
+		--------------------------------------------------------- */
+		/**
+		 * Construct from number of threads.
+		 *
+		 * @param size Number of threads to run the I/O service. Default is number of hardware threads.
+		 */
+		IOServicePool(size_t size = std::thread::hardware_concurrency())
+		{
+			if (size == 0)
+				size = 1;
+#ifdef SAMCHON_IO_URING
+			ring_index = 0;
+#endif
+
+			service = std::make_shared<boost::asio::io_service>();
+			work.reset(new boost::asio::io_service::work(*service));
+
+			threads.reserve(size);
+			for (size_t i = 0; i < size; i++)
+			{
+				std::shared_ptr<boost::asio::io_service> service = this->service;
+				threads.emplace_back([service]()
+				{
+					service->run();
+				});
+			}
+		};
+		IOServicePool(const IOServicePool &) = delete;
+
+		/**
+		 * Default Destructor.
+		 *
+		 * Stops the I/O service and joins the threads. If the pool is destructed in a handler, the thread running it 
+		 * can't join itself; it is detached, and finishes the handler on its own reference of the I/O service, never
+		 * referring the destructed pool.
+		 */
+		virtual ~IOServicePool()
+		{
+			stop();
+
+			for (auto it = threads.begin(); it != threads.end(); it++)
+				if (it->joinable() == true)
+					it->detach(); // THE CURRENT THREAD, HOLDING ITS OWN SERVICE
+		};
+
+		/**
+		 * Stop the I/O service.
+		 *
+		 * Joins the threads, except the current one if it's called in a handler. The current thread returns from the 
+		 * I/O service after the handler, and is joined by the destructor.
+		 */
+		void stop()
+		{
+			work.reset();
+			service->stop();
+
+			for (auto it = threads.begin(); it != threads.end(); it++)
+				if (it->joinable() == true && it->get_id() != std::this_thread::get_id())
+					it->join();
+
+#ifdef SAMCHON_IO_URING
+			for (auto it = rings.begin(); it != rings.end(); it++)
+				(*it)->stop();
+#endif
+		};
+
+		/**
+		 * Drive TCP connections by io_uring.
+		 *
+		 * Connections accepted or connected after this call are driven by *count* {@link IOUring io_urings}, each with a 
+		 * thread of its own, in turn. It must be called before opening servers or connecting; zero goes back to *epoll* 
+		 * for the later connections.
+		 *
+		 * @param count Number of {@link IOUring io_urings}. One serves tens of busy connections; add more for more cores.
+		 * @throw std::invalid_argument ```SAMCHON_IO_URING``` has not been defined.
+		 * @throw boost::system::system_error The kernel refused io_uring, or is older than 6.0.
+		 */
+		void setIOUring(size_t count)
+		{
+#ifdef SAMCHON_IO_URING
+			std::vector<std::shared_ptr<IOUring>> rings;
+			for (size_t i = 0; i < count; i++)
+				rings.emplace_back(new IOUring());
+
+			this->rings = rings;
+#else
+			if (count != 0)
+				throw std::invalid_argument("io_uring has not been compiled; define SAMCHON_IO_URING.");
+#endif
+		};
+
+		/* ---------------------------------------------------------
+			ACCESSORS
+		--------------------------------------------------------- */
+		/**
+		 * Get the I/O service.
+		 */
+		auto getService() -> boost::asio::io_service&
+		{
+			return *service;
+		};
+
+		/**
+		 * Get number of threads.
+		 */
+		auto size() const -> size_t
+		{
+			return threads.size();
+		};
+
+		/**
+		 * Get number of {@link IOUring io_urings}, zero for *epoll*.
+		 */
+		auto getIOUring() const -> size_t
+		{
+#ifdef SAMCHON_IO_URING
+			return rings.size();
+#else
+			return 0;
+#endif
+		};
+
+		/**
+		 * Wrap a connected TCP socket, created by the I/O service, to be driven by the pool.
+		 *
+		 * @param socket A TCP socket, which has been connected.
+		 * @return An {@link IOUringSocket} if {@link setIOUring io_uring} has been set, otherwise a {@link StreamSocket}.
+		 */
+		auto wrapSocket(std::shared_ptr<boost::asio::ip::tcp::socket> socket) -> std::shared_ptr<Socket>
+		{
+#ifdef SAMCHON_IO_URING
+			if (rings.empty() == false)
+				return std::make_shared<IOUringSocket>(socket, rings[ring_index++ % rings.size()]);
+#endif
+			return std::make_shared<StreamSocket<boost::asio::ip::tcp>>(socket);
+		};
+	};
+};
+};
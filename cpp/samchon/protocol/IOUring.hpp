@@ -0,0 +1,588 @@
+#pragma once
+#include <samchon/API.hpp>
+
+/* -------------------------------------------------------------------------
+	IO_URING OF LINUX, ONLY IF SAMCHON_IO_URING HAS BEEN DEFINED
+------------------------------------------------------------------------- */
+#ifdef SAMCHON_IO_URING
+#include <linux/io_uring.h>
+#ifndef IORING_RECV_MULTISHOT
+#	error "SAMCHON_IO_URING requires headers of Linux 6.0 or later."
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <boost/system/system_error.hpp>
+
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace samchon
+{
+namespace protocol
+{
+	/**
+	 * An io_uring of Linux, with a thread driving it.
+	 *
+	 * The {@link IOUring} is a backend of {@link IOUringSocket}, replacing the *epoll* reactor of ```boost::asio```
+	 * for sockets of an {@link IOServicePool}. Requested operations are queued and submitted in a batch, by a system
+	 * call which also waits for completions; a connection receives by a multishot receive, armed once, into buffers
+	 * registered to the kernel. Thus a busy system spends a few system calls for many messages, instead of one or
+	 * more for each.
+	 *
+	 * Completions are handled by the thread of the {@link IOUring}. Handlers of sockets are not called there; they're
+	 * posted to the I/O service, as the reactor of ```boost::asio``` does.
+	 *
+	 * The {@link IOUring} is created by {@link IOServicePool.setIOUring}; it is not used directly.
+	 *
+	 * @see {@link IOUringSocket}, {@link IOServicePool}
+	 * @author Jeongho Nam <http://samchon.org>
+	 */
+	class IOUring
+	{
+	public:
+		/**
+		 * Preparation of a submission, returning ```false``` to cancel it.
+		 *
+		 * The *user_data* of the submission has been set; it identifies the operation until its last completion.
+		 */
+		typedef std::function<bool(io_uring_sqe&)> Preparer;
+
+		/**
+		 * A function called with result and flags of a completion.
+		 *
+		 * A multishot operation is completed many times, with ```IORING_CQE_F_MORE``` but the last. The result is
+		 * ```-ECANCELED``` if the {@link IOUring} has been stopped.
+		 */
+		typedef std::function<void(int, unsigned)> Completer;
+
+		enum : unsigned short
+		{
+			/**
+			 * Group of the registered buffers, selected by receiving operations.
+			 */
+			BUFFER_GROUP = 0
+		};
+
+	private:
+		// AN OPERATION SUBMITTED, IN A LIST OF THOSE NOT COMPLETED YET
+		struct Operation
+		{
+			Preparer prepare;
+			Completer complete;
+
+			Operation *prev;
+			Operation *next;
+		};
+
+		int fd;
+		int event_fd;
+
+		// SUBMISSION QUEUE
+		void *sq_ptr;
+		size_t sq_size;
+		unsigned *sq_head;
+		unsigned *sq_tail;
+		unsigned sq_mask;
+		unsigned sq_entries;
+		unsigned *sq_array;
+		io_uring_sqe *sqes;
+		unsigned sq_local_tail;
+
+		// COMPLETION QUEUE
+		void *cq_ptr;
+		size_t cq_size;
+		unsigned *cq_head;
+		unsigned *cq_tail;
+		unsigned cq_mask;
+		io_uring_cqe *cqes;
+
+		// REGISTERED BUFFERS
+		io_uring_buf_ring *buffer_ring;
+		size_t buffer_ring_size;
+		unsigned char *buffers;
+		unsigned buffer_count;
+		unsigned buffer_size;
+		unsigned short buffer_tail;
+
+		// OPERATIONS REQUESTED, NOT SUBMITTED YET
+		std::mutex mutex;
+		std::vector<Operation*> requests;
+		bool signaled;
+		bool stopped;
+
+		// OPERATIONS SUBMITTED, NOT COMPLETED YET
+		Operation operations;
+
+		// THE SIGNAL, READ FROM THE EVENT_FD
+		unsigned long long wakeup;
+		bool waking;
+
+		std::thread thread;
+
+	public:
+		/* ---------------------------------------------------------
+			CONSTRUCTORS
+		--------------------------------------------------------- */
+		/**
+		 * Construct from sizes.
+		 *
+		 * @param entries Size of the submission queue, a power of 2.
+		 * @param buffer_count Number of registered buffers, a power of 2.
+		 * @param buffer_size Size of each registered buffer; a completion of receiving carries up to this size.
+		 *
+		 * @throw boost::system::system_error The kernel refused, or does not support, the io_uring.
+		 */
+		IOUring(unsigned entries = 1024, unsigned buffer_count = 1024, unsigned buffer_size = 16 * 1024)
+		{
+			fd = -1;
+			event_fd = -1;
+			sq_ptr = cq_ptr = MAP_FAILED;
+			sqes = (io_uring_sqe*)MAP_FAILED;
+			buffer_ring = (io_uring_buf_ring*)MAP_FAILED;
+			buffers = nullptr;
+
+			this->buffer_count = buffer_count;
+			this->buffer_size = buffer_size;
+			buffer_tail = 0;
+			sq_local_tail = 0;
+
+			signaled = false;
+			stopped = false;
+			waking = false;
+			operations.prev = operations.next = &operations;
+
+			try
+			{
+				setup(entries);
+				register_buffers();
+
+				event_fd = ::eventfd(0, EFD_CLOEXEC);
+				if (event_fd < 0)
+					throw_error(errno);
+			}
+			catch (...)
+			{
+				destroy();
+				throw;
+			}
+
+			thread = std::thread(&IOUring::run, this);
+		};
+		IOUring(const IOUring &) = delete;
+
+		/**
+		 * Default Destructor.
+		 */
+		virtual ~IOUring()
+		{
+			stop();
+			destroy();
+		};
+
+		/**
+		 * Stop the thread.
+		 *
+		 * Operations not completed yet are completed with ```-ECANCELED```, and those requested later too.
+		 */
+		void stop()
+		{
+			{
+				std::unique_lock<std::mutex> uk(mutex);
+				stopped = true;
+			}
+			signal();
+
+			if (thread.joinable() == false)
+				return;
+			else if (thread.get_id() == std::this_thread::get_id())
+				thread.detach();
+			else
+				thread.join();
+		};
+
+		/* ---------------------------------------------------------
+			OPERATIONS
+		--------------------------------------------------------- */
+		/**
+		 * Request an operation.
+		 *
+		 * The *prepare* is called by the thread of the {@link IOUring}, which submits all the operations requested
+		 * meanwhile in a batch. Then *complete* is called by the thread, for each completion of the operation.
+		 *
+		 * @param prepare A function filling the submission.
+		 * @param complete A function handling completions.
+		 */
+		void submit(Preparer prepare, Completer complete)
+		{
+			Operation *operation = new Operation();
+			operation->prepare = std::move(prepare);
+			operation->complete = std::move(complete);
+
+			bool signal;
+			{
+				std::unique_lock<std::mutex> uk(mutex);
+				if (stopped == true)
+				{
+					uk.unlock();
+
+					operation->complete(-ECANCELED, 0);
+					delete operation;
+					return;
+				}
+				requests.push_back(operation);
+
+				// THE THREAD ITSELF SUBMITS BEFORE WAITING
+				signal = (signaled == false && std::this_thread::get_id() != thread.get_id());
+				signaled = signaled || signal;
+			}
+
+			if (signal == true)
+				this->signal();
+		};
+
+		/**
+		 * Get a registered buffer, which a completion of receiving has filled.
+		 *
+		 * It's valid only in the *complete* function, until the buffer is {@link recycle recycled}.
+		 *
+		 * @param id ID of the buffer, ```flags >> IORING_CQE_BUFFER_SHIFT``` of the completion.
+		 */
+		auto getBuffer(unsigned short id) const -> unsigned char*
+		{
+			return buffers + (size_t)id * buffer_size;
+		};
+
+		/**
+		 * Return a registered buffer to the kernel.
+		 *
+		 * It must be called in the *complete* function, after consuming the buffer.
+		 *
+		 * @param id ID of the buffer.
+		 */
+		void recycle(unsigned short id)
+		{
+			// NOT BY THE FLEXIBLE ARRAY, WHICH IS MISPLACED IN C++
+			io_uring_buf &buffer = ((io_uring_buf*)buffer_ring)[buffer_tail & (buffer_count - 1)];
+			buffer.addr = (unsigned long long)getBuffer(id);
+			buffer.len = buffer_size;
+			buffer.bid = id;
+
+			buffer_tail++;
+			__atomic_store_n(&buffer_ring->tail, buffer_tail, __ATOMIC_RELEASE);
+		};
+
+	private:
+		/* ---------------------------------------------------------
+			INITIALIZATION
+		--------------------------------------------------------- */
+		void setup(unsigned entries)
+		{
+			io_uring_params params;
+			std::memset(&params, 0, sizeof(params));
+			params.flags = IORING_SETUP_CQSIZE | IORING_SETUP_COOP_TASKRUN | IORING_SETUP_SUBMIT_ALL;
+			params.cq_entries = entries * 4;
+
+			fd = (int)::syscall(__NR_io_uring_setup, entries, &params);
+			if (fd < 0 && errno == EINVAL)
+			{
+				// AN OLDER KERNEL, WITHOUT THE OPTIONAL FLAGS
+				std::memset(&params, 0, sizeof(params));
+				fd = (int)::syscall(__NR_io_uring_setup, entries, &params);
+			}
+			if (fd < 0)
+				throw_error(errno);
+
+			// MAP THE QUEUES
+			sq_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+			cq_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+
+			if (params.features & IORING_FEAT_SINGLE_MMAP)
+				sq_size = cq_size = std::max(sq_size, cq_size);
+
+			sq_ptr = ::mmap(nullptr, sq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+			if (sq_ptr == MAP_FAILED)
+				throw_error(errno);
+
+			if (params.features & IORING_FEAT_SINGLE_MMAP)
+				cq_ptr = sq_ptr;
+			else
+			{
+				cq_ptr = ::mmap(nullptr, cq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+				if (cq_ptr == MAP_FAILED)
+					throw_error(errno);
+			}
+
+			sqes = (io_uring_sqe*)::mmap(nullptr, params.sq_entries * sizeof(io_uring_sqe), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+			if (sqes == MAP_FAILED)
+				throw_error(errno);
+
+			unsigned char *sq = (unsigned char*)sq_ptr;
+			sq_head = (unsigned*)(sq + params.sq_off.head);
+			sq_tail = (unsigned*)(sq + params.sq_off.tail);
+			sq_mask = *(unsigned*)(sq + params.sq_off.ring_mask);
+			sq_entries = params.sq_entries;
+			sq_array = (unsigned*)(sq + params.sq_off.array);
+			sq_local_tail = *sq_tail;
+
+			unsigned char *cq = (unsigned char*)cq_ptr;
+			cq_head = (unsigned*)(cq + params.cq_off.head);
+			cq_tail = (unsigned*)(cq + params.cq_off.tail);
+			cq_mask = *(unsigned*)(cq + params.cq_off.ring_mask);
+			cqes = (io_uring_cqe*)(cq + params.cq_off.cqes);
+		};
+
+		void register_buffers()
+		{
+			buffer_ring_size = buffer_count * sizeof(io_uring_buf);
+			buffer_ring = (io_uring_buf_ring*)::mmap(nullptr, buffer_ring_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+			if (buffer_ring == MAP_FAILED)
+				throw_error(errno);
+
+			buffers = new unsigned char[(size_t)buffer_count * buffer_size];
+
+			io_uring_buf_reg reg;
+			std::memset(&reg, 0, sizeof(reg));
+			reg.ring_addr = (unsigned long long)buffer_ring;
+			reg.ring_entries = buffer_count;
+			reg.bgid = BUFFER_GROUP;
+
+			if (::syscall(__NR_io_uring_register, fd, IORING_REGISTER_PBUF_RING, &reg, 1) < 0)
+				throw_error(errno);
+
+			for (unsigned i = 0; i < buffer_count; i++)
+				recycle((unsigned short)i);
+		};
+
+		void destroy()
+		{
+			if (sqes != MAP_FAILED)
+				::munmap(sqes, sq_entries * sizeof(io_uring_sqe));
+			if (cq_ptr != MAP_FAILED && cq_ptr != sq_ptr)
+				::munmap(cq_ptr, cq_size);
+			if (sq_ptr != MAP_FAILED)
+				::munmap(sq_ptr, sq_size);
+			sqes = (io_uring_sqe*)MAP_FAILED;
+			sq_ptr = cq_ptr = MAP_FAILED;
+
+			// THE BUFFERS ARE UNREGISTERED BY CLOSING THE RING
+			if (fd >= 0)
+				::close(fd);
+			if (event_fd >= 0)
+				::close(event_fd);
+			fd = event_fd = -1;
+
+			if (buffer_ring != MAP_FAILED)
+				::munmap(buffer_ring, buffer_ring_size);
+			buffer_ring = (io_uring_buf_ring*)MAP_FAILED;
+
+			delete[] buffers;
+			buffers = nullptr;
+		};
+
+		static void throw_error(int code)
+		{
+			throw boost::system::system_error(boost::system::error_code(code, boost::system::system_category()), "io_uring");
+		};
+
+		/* ---------------------------------------------------------
+			MAIN LOOP
+		--------------------------------------------------------- */
+		void run()
+		{
+			std::vector<Operation*> batch;
+
+			while (true)
+			{
+				// TAKE THE REQUESTS
+				{
+					std::unique_lock<std::mutex> uk(mutex);
+					if (stopped == true)
+					{
+						batch.swap(requests);
+						break;
+					}
+
+					batch.swap(requests);
+					signaled = false;
+				}
+
+				// LISTEN THE SIGNAL OF NEXT REQUESTS
+				if (waking == false)
+					submit_wakeup();
+
+				for (auto it = batch.begin(); it != batch.end(); it++)
+					prepare(*it);
+				batch.clear();
+
+				// SUBMIT THEM ALL, AND WAIT FOR A COMPLETION, BY A SYSTEM CALL
+				enter(true);
+				reap();
+			}
+
+			// REQUESTS NOT SUBMITTED
+			for (auto it = batch.begin(); it != batch.end(); it++)
+			{
+				(*it)->complete(-ECANCELED, 0);
+				delete *it;
+			}
+
+			// THE KERNEL RELEASES BUFFERS OF OPERATIONS, BY CANCELING THEM
+			while (operations.next != &operations || waking == true)
+			{
+				io_uring_sqe *sqe = next_sqe();
+				if (sqe != nullptr)
+				{
+					std::memset(sqe, 0, sizeof(io_uring_sqe));
+					sqe->opcode = IORING_OP_ASYNC_CANCEL;
+					sqe->cancel_flags = IORING_ASYNC_CANCEL_ANY;
+					sqe->user_data = (unsigned long long)&operations;
+				}
+				enter(true);
+				reap();
+			}
+		};
+
+		void prepare(Operation *operation)
+		{
+			io_uring_sqe *sqe = next_sqe();
+			while (sqe == nullptr)
+			{
+				// THE QUEUE IS FULL, THEN SUBMIT WITHOUT WAITING
+				enter(false);
+				reap();
+
+				sqe = next_sqe();
+			}
+			std::memset(sqe, 0, sizeof(io_uring_sqe));
+			sqe->user_data = (unsigned long long)operation;
+
+			if (operation->prepare(*sqe) == false)
+			{
+				// CANCELED, THEN THE ENTRY BECOMES A NO-OP
+				std::memset(sqe, 0, sizeof(io_uring_sqe));
+				sqe->opcode = IORING_OP_NOP;
+				sqe->user_data = (unsigned long long)operation;
+
+				operation->complete = nullptr;
+			}
+			link(operation);
+		};
+
+		auto next_sqe() -> io_uring_sqe*
+		{
+			unsigned head = __atomic_load_n(sq_head, __ATOMIC_ACQUIRE);
+			if (sq_local_tail - head >= sq_entries)
+				return nullptr;
+
+			unsigned index = sq_local_tail & sq_mask;
+			sq_array[index] = index;
+			sq_local_tail++;
+
+			return &sqes[index];
+		};
+
+		void enter(bool wait)
+		{
+			unsigned submitting = sq_local_tail - *sq_tail;
+			__atomic_store_n(sq_tail, sq_local_tail, __ATOMIC_RELEASE);
+
+			while (true)
+			{
+				int ret = (int)::syscall(__NR_io_uring_enter, fd, submitting, wait ? 1 : 0, wait ? IORING_ENTER_GETEVENTS : 0, nullptr, 0);
+				if (ret >= 0)
+					break;
+				else if (errno == EINTR)
+					continue;
+				else if (errno == EAGAIN || errno == EBUSY)
+				{
+					// COMPLETIONS MUST BE CONSUMED FIRST
+					reap();
+					wait = false;
+					continue;
+				}
+				else
+					throw_error(errno);
+			}
+		};
+
+		void reap()
+		{
+			unsigned head = *cq_head;
+			unsigned tail = __atomic_load_n(cq_tail, __ATOMIC_ACQUIRE);
+
+			for (; head != tail; head++)
+			{
+				io_uring_cqe &cqe = cqes[head & cq_mask];
+				if (cqe.user_data == 0)
+				{
+					// THE SIGNAL HAS BEEN READ
+					waking = false;
+					continue;
+				}
+				else if (cqe.user_data == (unsigned long long)&operations)
+					continue;
+
+				Operation *operation = (Operation*)cqe.user_data;
+				if (operation->complete != nullptr)
+					operation->complete(cqe.res, cqe.flags);
+
+				if ((cqe.flags & IORING_CQE_F_MORE) == 0)
+				{
+					unlink(operation);
+					delete operation;
+				}
+			}
+			__atomic_store_n(cq_head, head, __ATOMIC_RELEASE);
+		};
+
+		/* ---------------------------------------------------------
+			SIGNAL
+		--------------------------------------------------------- */
+		void submit_wakeup()
+		{
+			io_uring_sqe *sqe = next_sqe();
+			if (sqe == nullptr)
+				return;
+			waking = true;
+
+			// USER_DATA OF ZERO
+			std::memset(sqe, 0, sizeof(io_uring_sqe));
+			sqe->opcode = IORING_OP_READ;
+			sqe->fd = event_fd;
+			sqe->addr = (unsigned long long)&wakeup;
+			sqe->len = sizeof(wakeup);
+		};
+
+		void signal()
+		{
+			unsigned long long value = 1;
+			ssize_t ret = ::write(event_fd, &value, sizeof(value));
+			(void)ret;
+		};
+
+		void link(Operation *operation)
+		{
+			operation->prev = operations.prev;
+			operation->next = &operations;
+			operations.prev->next = operation;
+			operations.prev = operation;
+		};
+
+		void unlink(Operation *operation)
+		{
+			operation->prev->next = operation->next;
+			operation->next->prev = operation->prev;
+		};
+	};
+};
+};
+#endif
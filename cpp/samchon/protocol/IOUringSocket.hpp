@@ -0,0 +1,409 @@
+#pragma once
+#include <samchon/API.hpp>
+
+#include <samchon/protocol/IOUring.hpp>
+#include <samchon/protocol/Socket.hpp>
+
+#ifdef SAMCHON_IO_URING
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+
+#include <sys/socket.h>
+
+namespace samchon
+{
+namespace protocol
+{
+	/**
+	 * A TCP {@link Socket} driven by an {@link IOUring}.
+	 *
+	 * The {@link IOUringSocket} receives by a multishot receive armed on the {@link IOUring}, which keeps receiving
+	 * into the registered buffers without a system call for each read. Received bytes are moved to the socket's own
+	 * buffer, from which reads are served. Asynchronous writes are submitted to the {@link IOUring} in batches with
+	 * those of the other sockets; synchronous writes are written directly.
+	 *
+	 * Bytes received but not read are bounded by a limit; over it, the multishot receive is canceled, so that TCP
+	 * pushes back the remote system, and it's armed again when half of them have been read.
+	 *
+	 * An {@link IOUringSocket} is created instead of a {@link StreamSocket} for a TCP connection, by an
+	 * {@link IOServicePool} whose {@link IOServicePool.setIOUring io_uring} has been set.
+	 *
+	 * @see {@link IOUring}, {@link IOServicePool}
+	 * @author Jeongho Nam <http://samchon.org>
+	 */
+	class IOUringSocket
+		: public Socket
+	{
+	private:
+		// RECEIVING SIDE, SHARED WITH OPERATIONS OF THE IO_URING
+		struct Receiver
+		{
+			std::mutex mutex;
+			std::condition_variable cv;
+
+			std::vector<unsigned char> data;
+			size_t first;
+			size_t limit;
+
+			// END OF THE STREAM OR AN ERROR, AFTER THE DATA
+			boost::system::error_code error;
+			bool closed;
+
+			// AN ASYNCHRONOUS READ WAITING FOR BYTES
+			boost::asio::mutable_buffer buffer;
+			Handler handler;
+
+			// WHETHER THE MULTISHOT RECEIVE IS ARMED, OR PAUSED BY THE LIMIT
+			bool paused;
+
+			// THE IO_URING'S THREAD ONLY
+			unsigned long long armed;
+			bool canceling;
+
+			Receiver()
+			{
+				first = 0;
+				closed = false;
+				paused = false;
+
+				armed = 0;
+				canceling = false;
+			};
+
+			auto size() const -> size_t
+			{
+				return data.size() - first;
+			};
+
+			auto read(boost::asio::mutable_buffer buffer) -> size_t
+			{
+				size_t size = std::min(buffer.size(), this->size());
+				std::memcpy(buffer.data(), data.data() + first, size);
+
+				first += size;
+				if (first == data.size())
+				{
+					data.clear();
+					first = 0;
+				}
+				else if (first >= 64 * 1024 && first >= data.size() / 2)
+				{
+					// READ PARTIALLY WHILE BYTES ARE ARRIVING
+					data.erase(data.begin(), data.begin() + first);
+					first = 0;
+				}
+				return size;
+			};
+		};
+
+		std::shared_ptr<boost::asio::ip::tcp::socket> socket;
+		std::shared_ptr<IOUring> ring;
+		std::shared_ptr<Receiver> receiver;
+
+	public:
+		/* ---------------------------------------------------------
+			CONSTRUCTORS
+		--------------------------------------------------------- */
+		/**
+		 * Construct from a connected socket.
+		 *
+		 * @param socket A TCP socket, which has been connected.
+		 * @param ring An {@link IOUring} to drive the *socket*.
+		 * @param limit Maximum bytes received but not read.
+		 */
+		IOUringSocket(std::shared_ptr<boost::asio::ip::tcp::socket> socket, std::shared_ptr<IOUring> ring, size_t limit = 4 * 1024 * 1024)
+			: socket(socket),
+			ring(ring),
+			receiver(new Receiver())
+		{
+			receiver->limit = limit;
+			arm(ring.get(), socket, receiver);
+		};
+
+		virtual ~IOUringSocket()
+		{
+			boost::system::error_code error;
+			close(error);
+		};
+
+		/**
+		 * Close the socket.
+		 *
+		 * The connection is shut down at once. The descriptor itself is closed when operations of the {@link IOUring}
+		 * referring it have been completed, so that it's never reused by another socket meanwhile.
+		 */
+		virtual void close(boost::system::error_code &error) override
+		{
+			Handler handler;
+			{
+				std::unique_lock<std::mutex> uk(receiver->mutex);
+				if (receiver->closed == true)
+					return;
+
+				receiver->closed = true;
+				handler = std::move(receiver->handler);
+				receiver->handler = nullptr;
+			}
+			receiver->cv.notify_all();
+
+			socket->shutdown(boost::asio::ip::tcp::socket::shutdown_both, error);
+			error.clear();
+			cancel(ring.get(), receiver);
+
+			if (handler != nullptr)
+				boost::asio::post(get_executor(), [handler]()
+				{
+					handler(boost::asio::error::operation_aborted, 0);
+				});
+		};
+
+		/* ---------------------------------------------------------
+			ACCESSORS
+		--------------------------------------------------------- */
+		virtual auto get_executor() -> executor_type override
+		{
+			return socket->get_executor();
+		};
+
+		virtual auto is_open() const -> bool override
+		{
+			std::unique_lock<std::mutex> uk(receiver->mutex);
+			return receiver->closed == false;
+		};
+
+	protected:
+		/* ---------------------------------------------------------
+			TRANSPORT
+		--------------------------------------------------------- */
+		virtual auto read_bytes(boost::asio::mutable_buffer buffer, boost::system::error_code &error) -> size_t override
+		{
+			size_t size = 0;
+			bool resume;
+			{
+				std::unique_lock<std::mutex> uk(receiver->mutex);
+				receiver->cv.wait(uk, [this]()
+				{
+					return receiver->size() != 0 || receiver->error || receiver->closed == true;
+				});
+
+				if (receiver->closed == true)
+					error = boost::asio::error::operation_aborted;
+				else if (receiver->size() != 0)
+					size = receiver->read(buffer);
+				else
+					error = receiver->error;
+
+				resume = should_resume();
+			}
+			if (resume == true)
+				arm(ring.get(), socket, receiver);
+
+			return size;
+		};
+
+		virtual void async_read_bytes(boost::asio::mutable_buffer buffer, Handler handler) override
+		{
+			boost::system::error_code error;
+			size_t size = 0;
+			bool resume;
+			{
+				std::unique_lock<std::mutex> uk(receiver->mutex);
+				if (receiver->closed == true)
+					error = boost::asio::error::operation_aborted;
+				else if (receiver->size() != 0)
+					size = receiver->read(buffer);
+				else if (receiver->error)
+					error = receiver->error;
+				else
+				{
+					// COMPLETED WHEN BYTES ARRIVE
+					receiver->buffer = buffer;
+					receiver->handler = std::move(handler);
+					return;
+				}
+				resume = should_resume();
+			}
+			if (resume == true)
+				arm(ring.get(), socket, receiver);
+
+			boost::asio::post(get_executor(), [handler, error, size]()
+			{
+				handler(error, size);
+			});
+		};
+
+		virtual auto write_bytes(const boost::asio::const_buffer *buffers, size_t count, boost::system::error_code &error) -> size_t override
+		{
+			return socket->write_some(std::vector<boost::asio::const_buffer>(buffers, buffers + count), error);
+		};
+
+		virtual void async_write_bytes(std::vector<boost::asio::const_buffer> buffers, Handler handler) override
+		{
+			struct Message
+			{
+				std::vector<iovec> vectors;
+				msghdr header;
+			};
+			std::shared_ptr<Message> message(new Message());
+			for (auto it = buffers.begin(); it != buffers.end(); it++)
+				message->vectors.push_back({ (void*)it->data(), it->size() });
+
+			std::memset(&message->header, 0, sizeof(msghdr));
+			message->header.msg_iov = message->vectors.data();
+			message->header.msg_iovlen = message->vectors.size();
+
+			// THE SOCKET OUTLIVES THE OPERATION, NOT TO REUSE ITS DESCRIPTOR
+			std::shared_ptr<boost::asio::ip::tcp::socket> socket = this->socket;
+			executor_type executor = get_executor();
+
+			ring->submit([socket, message](io_uring_sqe &sqe) -> bool
+			{
+				sqe.opcode = IORING_OP_SENDMSG;
+				sqe.fd = socket->native_handle();
+				sqe.addr = (unsigned long long)&message->header;
+				sqe.len = 1;
+				sqe.msg_flags = MSG_NOSIGNAL;
+
+				return true;
+			}, [socket, message, executor, handler](int result, unsigned)
+			{
+				boost::system::error_code error;
+				size_t size = 0;
+
+				if (result < 0)
+					error.assign(-result, boost::system::system_category());
+				else
+					size = (size_t)result;
+
+				boost::asio::post(executor, [handler, error, size]()
+				{
+					handler(error, size);
+				});
+			});
+		};
+
+	private:
+		/* ---------------------------------------------------------
+			MULTISHOT RECEIVE
+		--------------------------------------------------------- */
+		// WHETHER A PAUSED RECEIVE HAS TO BE ARMED AGAIN, WITH THE LOCK
+		auto should_resume() -> bool
+		{
+			if (receiver->paused == false || receiver->closed == true || receiver->size() > receiver->limit / 2)
+				return false;
+
+			receiver->paused = false;
+			return true;
+		};
+
+		// THE IO_URING OUTLIVES ITS OPERATIONS
+		static void arm(IOUring *ring, std::shared_ptr<boost::asio::ip::tcp::socket> socket, std::shared_ptr<Receiver> receiver)
+		{
+			ring->submit([socket, receiver](io_uring_sqe &sqe) -> bool
+			{
+				if (receiver->armed != 0)
+					return false;
+
+				sqe.opcode = IORING_OP_RECV;
+				sqe.fd = socket->native_handle();
+				sqe.ioprio = IORING_RECV_MULTISHOT;
+				sqe.flags = IOSQE_BUFFER_SELECT;
+				sqe.buf_group = IOUring::BUFFER_GROUP;
+
+				receiver->armed = sqe.user_data;
+				receiver->canceling = false;
+				return true;
+			}, [ring, socket, receiver](int result, unsigned flags)
+			{
+				handle_receive(ring, socket, receiver, result, flags);
+			});
+		};
+
+		static void cancel(IOUring *ring, std::shared_ptr<Receiver> receiver)
+		{
+			ring->submit([receiver](io_uring_sqe &sqe) -> bool
+			{
+				if (receiver->armed == 0 || receiver->canceling == true)
+					return false;
+
+				sqe.opcode = IORING_OP_ASYNC_CANCEL;
+				sqe.addr = receiver->armed;
+
+				receiver->canceling = true;
+				return true;
+			}, [receiver](int, unsigned) {});
+		};
+
+		static void handle_receive(IOUring *ring, std::shared_ptr<boost::asio::ip::tcp::socket> socket, std::shared_ptr<Receiver> receiver, int result, unsigned flags)
+		{
+			bool more = (flags & IORING_CQE_F_MORE) != 0;
+			if (more == false)
+				receiver->armed = 0;
+
+			Handler handler;
+			boost::system::error_code error;
+			size_t size = 0;
+			bool rearm = false;
+			bool pause = false;
+			{
+				std::unique_lock<std::mutex> uk(receiver->mutex);
+
+				if (flags & IORING_CQE_F_BUFFER)
+				{
+					// MOVE THE BYTES, THEN RETURN THE BUFFER
+					unsigned short id = (unsigned short)(flags >> IORING_CQE_BUFFER_SHIFT);
+					if (result > 0 && receiver->closed == false)
+					{
+						unsigned char *data = ring->getBuffer(id);
+						receiver->data.insert(receiver->data.end(), data, data + result);
+					}
+					ring->recycle(id);
+				}
+				else if (result == 0)
+					receiver->error = boost::asio::error::eof;
+				else if (result < 0 && result != -ENOBUFS && result != -ECANCELED)
+					receiver->error.assign(-result, boost::system::system_category());
+
+				if (receiver->closed == false && more == false && !receiver->error)
+				{
+					// OUT OF THE REGISTERED BUFFERS, OR CANCELED BY THE LIMIT
+					if (receiver->size() < receiver->limit)
+						rearm = true;
+					else
+						receiver->paused = true;
+				}
+				else if (more == true && receiver->size() >= receiver->limit)
+					pause = true;
+
+				// COMPLETE THE PENDING READ
+				if (receiver->handler != nullptr && (receiver->size() != 0 || receiver->error))
+				{
+					if (receiver->size() != 0)
+						size = receiver->read(receiver->buffer);
+					else
+						error = receiver->error;
+
+					handler = std::move(receiver->handler);
+					receiver->handler = nullptr;
+				}
+			}
+			receiver->cv.notify_all();
+
+			if (handler != nullptr)
+				boost::asio::post(socket->get_executor(), [handler, error, size]()
+				{
+					handler(error, size);
+				});
+
+			// SUBMITTED BEFORE THE NEXT WAIT OF THE THREAD
+			if (rearm == true)
+				arm(ring, socket, receiver);
+			else if (pause == true)
+				cancel(ring, receiver);
+		};
+	};
+};
+};
+#endif
@@ -35,6 +35,9 @@ namespace protocol
 	class Invoke
 		: public SharedEntityArray<InvokeParameter>
 	{
+		friend class InvokePool;
+		friend class Communicator;
+
 	private:
 		typedef SharedEntityArray<InvokeParameter> super;
 
@@ -44,12 +47,23 @@ namespace protocol
 		 */
 		std::string listener;
 
+	private:
+		/**
+		 * @brief ID of a request sent by Communicator::call(), zero if the Invoke is not a request
+		 *
+		 * @details
+		 * <p> The ID arrives as the last parameter, but it is taken out of the parameters before the listener gets the
+		 * Invoke. Communicator::sendReply() finds the ID here. </p>
+		 */
+		size_t call_uid;
+
 	public:
 		/* --------------------------------------------------------------------
 			CONSTRUCTORS
 		-------------------------------------------------------------------- */
 		Invoke() : super()
 		{
+			call_uid = 0;
 		};
 
 		/**
@@ -60,6 +74,7 @@ namespace protocol
 		Invoke(const std::string &listener)
 		{
 			this->listener = listener;
+			this->call_uid = 0;
 		};
 
 		virtual ~Invoke() = default;
@@ -144,6 +159,14 @@ namespace protocol
 			return listener;
 		};
 
+		/**
+		 * @brief Refer listener, without copying
+		 */
+		auto referListener() const -> const std::string&
+		{
+			return listener;
+		};
+
 		/**
 		 * @brief Set listener
 		 */
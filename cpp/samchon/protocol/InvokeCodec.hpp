@@ -0,0 +1,338 @@
+#pragma once
+#include <samchon/API.hpp>
+
+#include <samchon/protocol/Invoke.hpp>
+#include <samchon/protocol/InvokePool.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <stdexcept>
+#include <samchon/ByteArray.hpp>
+
+namespace samchon
+{
+namespace protocol
+{
+	/**
+	 * Compact binary encoding of {@link Invoke} messages.
+	 *
+	 * The {@link InvokeCodec} encodes an {@link Invoke} message to a length-prefixed binary frame and decodes it back,
+	 * without building and parsing an intermediate {@link library::XML} object. It is an alternative of the XML encoding
+	 * ({@link Invoke.toXML Invoke.toXML()}), which is used only when both sides of a connection have agreed on it. See
+	 * {@link ServerConnector.setBinaryEncoding ServerConnector.setBinaryEncoding()}.
+	 *
+	 * An encoded frame starts with the {@link SIGNATURE} byte, that can't be the first byte of an XML document. Thus a
+	 * receiver can tell a binary frame from an XML frame by its first byte alone.
+	 *
+	 * Segment             | Layout
+	 * --------------------|------------------------------------------------------------
+	 * Frame               | {@link SIGNATURE}, listener, number of parameters, parameters
+	 * String              | varint length, bytes
+	 * Parameter           | {@link TypeCode type code}, name, (type name,) value
+	 * Value of number     | {@link INTEGER}: zigzag varint. {@link UNSIGNED_INTEGER}: varint. {@link NUMBER}: IEEE 754
+	 *                     | double, 8 bytes in little endian.
+	 * Value of ByteArray  | varint size. The bytes follow in a separated frame, as XML encoding does.
+	 * Value of ByteStream | varint size plus two, one if not known, zero if null. Chunks of a stream not null follow in
+	 *                     | ```_Stream_chunk``` messages.
+	 *
+	 * @see {@link Invoke}, {@link Communicator}
+	 * @author Jeongho Nam <http://samchon.org>
+	 */
+	class InvokeCodec
+	{
+	public:
+		/**
+		 * The first byte of an encoded frame.
+		 */
+		static const unsigned char SIGNATURE = 0x01;
+
+		/**
+		 * Codes of {@link InvokeParameter.getType parameter types}.
+		 *
+		 * The codes are same with {@link InvokeParameter.TypeCode}, except {@link INTEGER} and
+		 * {@link UNSIGNED_INTEGER}, which are numbers held as integers.
+		 */
+		enum TypeCode : unsigned char
+		{
+			CUSTOM = 0,
+			NUMBER = 1,
+			STRING = 2,
+			XML = 3,
+			BYTE_ARRAY = 4,
+			BYTE_STREAM = 5,
+			INTEGER = 6,
+			UNSIGNED_INTEGER = 7
+		};
+
+		/**
+		 * Name of the binary encoding, used in negotiation.
+		 */
+		static auto NAME() -> std::string
+		{
+			return "binary";
+		};
+
+		/**
+		 * Test whether a frame is encoded by {@link InvokeCodec}.
+		 *
+		 * @param data Content of the frame.
+		 * @param size Size of the frame.
+		 */
+		static auto isBinary(const unsigned char *data, size_t size) -> bool
+		{
+			return size != 0 && data[0] == SIGNATURE;
+		};
+
+		/* ---------------------------------------------------------
+			ENCODER
+		--------------------------------------------------------- */
+		/**
+		 * Encode an {@link Invoke} message.
+		 *
+		 * @param invoke An {@link Invoke} message to encode.
+		 * @return A binary frame representing the *invoke*.
+		 */
+		static auto encode(const Invoke &invoke) -> ByteArray
+		{
+			ByteArray data;
+			data.reserve(64 * (invoke.size() + 1));
+
+			data.write((unsigned char)SIGNATURE);
+			write_string(data, invoke.getListener());
+			write_size(data, invoke.size());
+
+			for (size_t i = 0; i < invoke.size(); i++)
+			{
+				const InvokeParameter &parameter = *invoke.at(i);
+				TypeCode code = (TypeCode)parameter.type;
+
+				// A NUMBER, BY ITS NATIVE FORM
+				if (code == NUMBER && boost::get<long long>(&parameter.value) != nullptr)
+					code = INTEGER;
+				else if (code == NUMBER && boost::get<unsigned long long>(&parameter.value) != nullptr)
+					code = UNSIGNED_INTEGER;
+				else if (code == NUMBER && boost::get<double>(&parameter.value) == nullptr)
+					code = CUSTOM; // NOT A NUMBER, KEEP THE TEXT
+
+				data.write((unsigned char)code);
+				write_string(data, parameter.name);
+				if (code == CUSTOM)
+					write_string(data, parameter.getType());
+
+				if (code == XML)
+				{
+					std::shared_ptr<library::XML> xml = parameter.getValueAsXML();
+					write_string(data, (xml == nullptr) ? "" : xml->toString());
+				}
+				else if (code == BYTE_ARRAY)
+					write_size(data, boost::get<ByteArray>(parameter.value).size());
+				else if (code == BYTE_STREAM)
+				{
+					const std::shared_ptr<ByteStream> &byte_stream = boost::get<std::shared_ptr<ByteStream>>(parameter.value);
+					if (byte_stream == nullptr)
+						write_size(data, 0);
+					else if (byte_stream->size() == ByteStream::npos)
+						write_size(data, 1);
+					else
+						write_size(data, byte_stream->size() + 2);
+				}
+				else if (code == INTEGER)
+					write_integer(data, boost::get<long long>(parameter.value));
+				else if (code == UNSIGNED_INTEGER)
+					write_size(data, (size_t)boost::get<unsigned long long>(parameter.value));
+				else if (code == NUMBER)
+					write_double(data, boost::get<double>(parameter.value));
+				else
+					write_string(data, boost::get<std::string>(parameter.value));
+			}
+			return data;
+		};
+
+		/* ---------------------------------------------------------
+			DECODER
+		--------------------------------------------------------- */
+		/**
+		 * Decode a binary frame.
+		 *
+		 * Parameters of *ByteArray* type are constructed with their capacity only. Their contents arrive in following
+		 * frames, as XML encoding does.
+		 *
+		 * The message and its parameters are taken from the {@link InvokePool} of the calling thread.
+		 *
+		 * @param data Content of the frame, starting with {@link SIGNATURE}.
+		 * @param size Size of the frame.
+		 *
+		 * @return The decoded {@link Invoke} message.
+		 * @throw domain_error If the frame is malformed.
+		 */
+		static auto decode(const unsigned char *data, size_t size) -> std::shared_ptr<Invoke>
+		{
+			const unsigned char *last = data + size;
+			if (isBinary(data, size) == false)
+				throw std::domain_error("not a binary invoke frame.");
+			data++;
+
+			InvokePool &pool = InvokePool::get();
+
+			std::shared_ptr<Invoke> invoke = pool.createInvoke(read_string(data, last));
+			size_t count = read_size(data, last);
+
+			invoke->reserve(count);
+			for (size_t i = 0; i < count; i++)
+			{
+				if (data == last)
+					throw std::domain_error("binary invoke frame is truncated.");
+
+				TypeCode code = (TypeCode)*data++;
+				std::shared_ptr<InvokeParameter> parameter = pool.createParameter();
+				invoke->push_back(parameter);
+
+				parameter->name = read_string(data, last);
+
+				if (code == CUSTOM)
+				{
+					parameter->set_type(read_string(data, last));
+
+					const std::string &str = read_string(data, last);
+					if (parameter->type == NUMBER)
+						parameter->value = InvokeParameter::parse_number(str);
+					else
+						parameter->value = str;
+				}
+				else if (code == INTEGER || code == UNSIGNED_INTEGER || code == NUMBER)
+				{
+					parameter->type = InvokeParameter::NUMBER;
+					if (code == INTEGER)
+						parameter->value = read_integer(data, last);
+					else if (code == UNSIGNED_INTEGER)
+						parameter->value = (unsigned long long)read_size(data, last);
+					else
+						parameter->value = read_double(data, last);
+				}
+				else if (code == STRING)
+				{
+					parameter->type = InvokeParameter::STRING;
+					parameter->value = read_string(data, last);
+				}
+				else if (code == XML)
+				{
+					parameter->type = InvokeParameter::XML;
+
+					const std::string &str = read_string(data, last);
+					parameter->value = str.empty()
+						? std::shared_ptr<library::XML>(nullptr)
+						: std::make_shared<library::XML>(str);
+				}
+				else if (code == BYTE_ARRAY)
+				{
+					parameter->type = InvokeParameter::BYTE_ARRAY;
+					parameter->value = ByteArray();
+					boost::get<ByteArray>(parameter->value).reserve(read_size(data, last));
+				}
+				else if (code == BYTE_STREAM)
+				{
+					parameter->type = InvokeParameter::BYTE_STREAM;
+
+					size_t stream_size = read_size(data, last);
+					if (stream_size == 0)
+						parameter->value = std::shared_ptr<ByteStream>(nullptr);
+					else
+						parameter->value = std::make_shared<ByteStream>(stream_size == 1 ? ByteStream::npos : stream_size - 2);
+				}
+				else
+					throw std::domain_error("unknown parameter type in binary invoke frame.");
+			}
+			return invoke;
+		};
+
+	private:
+		/* ---------------------------------------------------------
+			PRIMITIVES
+		--------------------------------------------------------- */
+		static void write_size(ByteArray &data, size_t size)
+		{
+			// LEB128 VARINT
+			while (size >= 0x80)
+			{
+				data.write((unsigned char)(size | 0x80));
+				size >>= 7;
+			}
+			data.write((unsigned char)size);
+		};
+
+		static void write_string(ByteArray &data, const std::string &str)
+		{
+			write_size(data, str.size());
+			data.insert(data.end(), str.begin(), str.end());
+		};
+
+		static void write_integer(ByteArray &data, long long val)
+		{
+			// ZIGZAG, FOR SMALL NEGATIVE NUMBERS TO BE SHORT
+			write_size(data, ((uint64_t)val << 1) ^ (uint64_t)(val >> 63));
+		};
+
+		static void write_double(ByteArray &data, double val)
+		{
+			uint64_t bits;
+			std::memcpy(&bits, &val, sizeof(bits));
+
+			for (size_t i = 0; i < 8; i++)
+				data.write((unsigned char)(bits >> (8 * i)));
+		};
+
+		static auto read_size(const unsigned char *&data, const unsigned char *last) -> size_t
+		{
+			size_t size = 0;
+
+			for (size_t shift = 0; shift < 64; shift += 7)
+			{
+				if (data == last)
+					break;
+
+				unsigned char byte = *data++;
+				size |= (size_t)(byte & 0x7F) << shift;
+
+				if ((byte & 0x80) == 0)
+					return size;
+			}
+			throw std::domain_error("binary invoke frame has an invalid length.");
+		};
+
+		static auto read_integer(const unsigned char *&data, const unsigned char *last) -> long long
+		{
+			uint64_t zigzag = read_size(data, last);
+
+			return (long long)(zigzag >> 1) ^ -(long long)(zigzag & 1);
+		};
+
+		static auto read_double(const unsigned char *&data, const unsigned char *last) -> double
+		{
+			if (last - data < 8)
+				throw std::domain_error("binary invoke frame is truncated.");
+
+			uint64_t bits = 0;
+			for (size_t i = 0; i < 8; i++)
+				bits |= (uint64_t)*data++ << (8 * i);
+
+			double val;
+			std::memcpy(&val, &bits, sizeof(val));
+
+			return val;
+		};
+
+		static auto read_string(const unsigned char *&data, const unsigned char *last) -> std::string
+		{
+			size_t size = read_size(data, last);
+			if (size > (size_t)(last - data))
+				throw std::domain_error("binary invoke frame is truncated.");
+
+			std::string str((const char*)data, size);
+			data += size;
+
+			return str;
+		};
+	};
+};
+};
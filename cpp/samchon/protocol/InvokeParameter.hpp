@@ -1,8 +1,16 @@
 #pragma once
 #include <samchon/protocol/Entity.hpp>
 
+#include <cerrno>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
 #include <sstream>
+#include <stdexcept>
+#include <type_traits>
+#include <boost/variant.hpp>
 #include <samchon/ByteArray.hpp>
+#include <samchon/protocol/ByteStream.hpp>
 #include <samchon/WeakString.hpp>
 
 namespace samchon
@@ -10,6 +18,8 @@ namespace samchon
 namespace protocol
 {
 	class Invoke;
+	class InvokeCodec;
+	class InvokePool;
 
 	/**
 	 * @brief A parameter of an Invoke.
@@ -23,10 +33,16 @@ namespace protocol
 	 *	\li XML
 	 *	\li ByteArray
 	 *
+	 * <p> A ByteStream, streamed chunk by chunk, can be a parameter instead of a ByteArray too large to
+	 * hold in memory. </p>
+	 *
 	 * <p> You can specify InvokeParameter to have some type which is not one of the basic 4 types, but
 	 * values of the custom type must be enable to expressed by one of those types; number, string, XML
 	 * and ByteArray. </p>
 	 *
+	 * <p> A value is held in its native form; a number as a 64-bit integer or a double, not as a string. It is
+	 * formatted to text only when the parameter is exported to XML or referenced as a string. </p>
+	 *
 	 * ![Basic Components](http://samchon.github.io/framework/images/design/cpp_class_diagram/protocol_invoke.png)
 	 *
 	 * @note
@@ -48,10 +64,37 @@ namespace protocol
 		: public virtual Entity<>
 	{
 		friend class Invoke;
+		friend class InvokeCodec;
+		friend class InvokePool;
+
+	public:
+		/**
+		 * @brief Codes of the pre-defined types
+		 */
+		enum TypeCode : unsigned char
+		{
+			CUSTOM = 0,
+			NUMBER = 1,
+			STRING = 2,
+			XML = 3,
+			BYTE_ARRAY = 4,
+			BYTE_STREAM = 5
+		};
 
 	protected:
 		typedef Entity<std::string> super;
 
+		/**
+		 * @brief Storage of a value
+		 *
+		 * @details
+		 * <p> A number is held by <i>long long</i> if it's an integer, by <i>unsigned long long</i> if it's an
+		 * integer over range of the <i>long long</i>, otherwise by <i>double</i>. A value of a custom type is held
+		 * by <i>std::string</i>. </p>
+		 */
+		typedef boost::variant<std::string, long long, unsigned long long, double,
+			std::shared_ptr<library::XML>, ByteArray, std::shared_ptr<ByteStream>> value_type;
+
 		/**
 		 * @brief A name can represent the parameter
 		 */
@@ -67,22 +110,25 @@ namespace protocol
 		 *	\li XML
 		 *	\li ByteArray
 		 */
-		std::string type;
+		TypeCode type;
 
 		/**
-		 * @brief A string value if the type is "string" or "number"
+		 * @brief Name of the type if the type is CUSTOM
 		 */
-		std::string str;
+		std::string custom_type;
 
 		/**
-		 * @brief An XML object if the type is "XML"
+		 * @brief The value
 		 */
-		std::shared_ptr<library::XML> xml;
+		value_type value;
 
 		/**
-		 * @brief A binary value if the type is "ByteArray"
+		 * @brief Text of a number, formatted on demand
+		 *
+		 * @details
+		 * <p> Formatted when a number is referenced as a string; by referValue() or getValue<WeakString>(). </p>
 		 */
-		ByteArray byte_array;
+		mutable std::string text;
 
 	public:
 		/* ----------------------------------------------------------
@@ -93,6 +139,7 @@ namespace protocol
 		 */
 		InvokeParameter()
 		{
+			this->type = STRING;
 		};
 
 		/**
@@ -112,8 +159,19 @@ namespace protocol
 		InvokeParameter(const std::string &name, const std::string &type, const std::string &val)
 		{
 			this->name = name;
-			this->type = type;
-			this->str = val;
+			set_type(type);
+
+			if (this->type == NUMBER)
+				this->value = parse_number(val);
+			else if (this->type == XML)
+			{
+				if (val.empty() == false)
+					this->value = std::make_shared<library::XML>(val);
+			}
+			else if (this->type == BYTE_ARRAY)
+				boost::get<ByteArray>(value).assign(val.begin(), val.end());
+			else if (this->type == STRING || this->type == CUSTOM)
+				this->value = val;
 		};
 
 		/**
@@ -160,9 +218,9 @@ namespace protocol
 		InvokeParameter(const std::string &name, const char *ptr)
 		{
 			this->name = name;
-			this->type = "string";
+			this->type = STRING;
 
-			this->str = ptr;
+			this->value = std::string(ptr);
 		};
 
 		//MOVE CONSTRUCTORS
@@ -172,9 +230,9 @@ namespace protocol
 		InvokeParameter(const std::string &name, std::string &&str)
 		{
 			this->name = name;
-			this->type = "string";
+			this->type = STRING;
 
-			this->str = move(str);
+			this->value = move(str);
 		};
 
 		/**
@@ -183,9 +241,9 @@ namespace protocol
 		InvokeParameter(const std::string &name, ByteArray &&byte_array)
 		{
 			this->name = name;
-			this->type = "ByteArray";
+			this->type = BYTE_ARRAY;
 
-			this->byte_array = move(byte_array);
+			this->value = move(byte_array);
 		};
 
 		virtual ~InvokeParameter() = default;
@@ -197,66 +255,78 @@ namespace protocol
 			else
 				this->name = "";
 
-			this->type = xml->getProperty("type");
+			set_type(xml->getProperty("type"));
 
-			if (type == "XML")
+			if (type == XML)
 			{
 				if (xml->empty())
-					this->xml = nullptr;
+					this->value = std::shared_ptr<library::XML>(nullptr);
 				else
-					this->xml = xml->begin()->second->at(0);
+					this->value = xml->begin()->second->at(0);
 			}
-			else if (type == "ByteArray")
+			else if (type == BYTE_ARRAY)
 			{
 				size_t size = xml->getValue<size_t>();
 
-				byte_array.reserve(size);
+				boost::get<ByteArray>(value).reserve(size);
 			}
+			else if (type == BYTE_STREAM)
+			{
+				// EMPTY VALUE FOR A NULL STREAM
+				const std::string &size = xml->getValue();
+				if (size.empty() == false)
+					this->value = std::make_shared<ByteStream>((size_t)std::stoull(size));
+			}
+			else if (type == NUMBER)
+				this->value = parse_number(xml->getValue());
 			else
-				this->str = xml->getValue();
+				this->value = xml->getValue();
 		};
 
 		auto byteArrayCapacity() const -> size_t
 		{
-			return byte_array.capacity();
+			const ByteArray *byte_array = boost::get<ByteArray>(&value);
+
+			return (byte_array == nullptr) ? 0 : byte_array->capacity();
 		};
 
 		void setByteArray(ByteArray &&ba)
 		{
-			byte_array = move(ba);
+			value = move(ba);
 		};
 
 	protected:
 		template <typename T>
 		void construct_by_varadic_template(const T &val)
 		{
-			this->type = "number";
-
-			std::stringstream sstream;
-			sstream << val;
-
-			this->str = move(sstream.str());
+			this->type = NUMBER;
+			this->value = make_number(val, number_kind<T>());
 		};
 		template<> void construct_by_varadic_template(const std::string &str)
 		{
-			this->type = "string";
-			this->str = str;
+			this->type = STRING;
+			this->value = str;
 		};
 		template<> void construct_by_varadic_template(const WeakString &wstr)
 		{
-			this->type = "string";
-			this->str = wstr.str();
+			this->type = STRING;
+			this->value = wstr.str();
 		};
 		template<> void construct_by_varadic_template(const ByteArray &byte_array)
 		{
-			this->type = "ByteArray";
-			this->byte_array = byte_array;
+			this->type = BYTE_ARRAY;
+			this->value = byte_array;
+		};
+		template<> void construct_by_varadic_template(const std::shared_ptr<ByteStream> &byte_stream)
+		{
+			this->type = BYTE_STREAM;
+			this->value = byte_stream;
 		};
 
 		template<> void construct_by_varadic_template(const std::shared_ptr<library::XML> &xml)
 		{
-			this->type = "XML";
-			this->xml = xml;
+			this->type = XML;
+			this->value = xml;
 		};
 
 	public:
@@ -280,6 +350,25 @@ namespace protocol
 		 * @brief Get type
 		 */
 		auto getType() const->std::string
+		{
+			switch (type)
+			{
+			case NUMBER:		return "number";
+			case STRING:		return "string";
+			case XML:			return "XML";
+			case BYTE_ARRAY:	return "ByteArray";
+			case BYTE_STREAM:	return "ByteStream";
+			default:			return custom_type;
+			}
+		};
+
+		/**
+		 * @brief Get code of the type
+		 *
+		 * @details
+		 * <p> Cheaper than getType() to test the type; CUSTOM for a type not pre-defined. </p>
+		 */
+		auto getTypeCode() const -> TypeCode
 		{
 			return type;
 		};
@@ -287,29 +376,57 @@ namespace protocol
 		/**
 		 * @brief Get value
 		 *
+		 * @details
+		 * <p> A number is converted from its native form directly, so that a 64-bit integer keeps its
+		 * precision. A number from a string value is parsed, in which "true" and "false" are 1 and 0. </p>
+		 *
 		 * @tparam _Ty Type of value to get
+		 * @throw invalid_argument If the value is not a number.
 		 */
 		template<typename T> auto getValue() const -> T
 		{
-			double val = std::stod(str);
-
-			return (T)val;
+			T val;
+			if (cast_number(value, val) == true)
+				return val;
+
+			const std::string *str = boost::get<std::string>(&value);
+			if (str == nullptr)
+				throw std::invalid_argument("a parameter is not a number: " + name);
+			else if (*str == "true")
+				return (T)1;
+			else if (*str == "false")
+				return (T)0;
+			else if (cast_number(parse_number(*str), val) == true)
+				return val;
+			else
+				throw std::invalid_argument("a parameter is not a number: " + *str);
 		};
 		template<> auto getValue() const -> std::string
 		{
-			return str;
+			if (const std::string *str = boost::get<std::string>(&value))
+				return *str;
+			else
+				return format_text();
 		};
 		template<> auto getValue() const -> WeakString
 		{
-			return str;
+			return refer_text();
 		};
 		template<> auto getValue() const -> std::shared_ptr<library::XML>
 		{
-			return xml;
+			return getValueAsXML();
 		};
 		template<> auto getValue() const -> ByteArray
 		{
-			return byte_array;
+			const ByteArray *byte_array = boost::get<ByteArray>(&value);
+
+			return (byte_array == nullptr) ? ByteArray() : *byte_array;
+		};
+		template<> auto getValue() const -> std::shared_ptr<ByteStream>
+		{
+			const std::shared_ptr<ByteStream> *byte_stream = boost::get<std::shared_ptr<ByteStream>>(&value);
+
+			return (byte_stream == nullptr) ? nullptr : *byte_stream;
 		};
 
 		/**
@@ -318,22 +435,28 @@ namespace protocol
 		 */
 		auto getValueAsXML() const -> std::shared_ptr<library::XML>
 		{
-			return xml;
+			const std::shared_ptr<library::XML> *xml = boost::get<std::shared_ptr<library::XML>>(&value);
+
+			return (xml == nullptr) ? nullptr : *xml;
 		};
 
 		/**
 		 * @brief Reference value
 		 *
+		 * @details
+		 * <p> A number is referenced as a string by its text, which is formatted at the first reference. </p>
+		 *
 		 * @tparam _Ty Type of value to reference
+		 * @throw boost::bad_get If a ByteArray is referenced from a parameter of other type.
 		 */
 		template <typename T> auto referValue() const -> const T&;
 		template<> auto referValue() const -> const std::string&
 		{
-			return str;
+			return refer_text();
 		};
 		template<> auto referValue() const -> const ByteArray&
 		{
-			return byte_array;
+			return boost::get<ByteArray>(value);
 		};
 
 		/**
@@ -344,11 +467,156 @@ namespace protocol
 		template <typename T> auto moveValue() -> T;
 		template<> auto moveValue() -> std::string
 		{
-			return move(str);
+			if (std::string *str = boost::get<std::string>(&value))
+				return move(*str);
+			else
+				return getValue<std::string>();
 		};
 		template<> auto moveValue() -> ByteArray
 		{
-			return move(byte_array);
+			return move(boost::get<ByteArray>(value));
+		};
+
+	private:
+		void set_type(const std::string &type_name)
+		{
+			if (type_name == "number")
+				type = NUMBER;
+			else if (type_name == "string")
+				type = STRING;
+			else if (type_name == "XML")
+				type = XML;
+			else if (type_name == "ByteArray")
+				type = BYTE_ARRAY;
+			else if (type_name == "ByteStream")
+				type = BYTE_STREAM;
+			else
+			{
+				type = CUSTOM;
+				custom_type = type_name;
+			}
+			text.clear();
+
+			// EMPTY VALUE OF THE TYPE
+			if (type == XML)
+				value = std::shared_ptr<library::XML>(nullptr);
+			else if (type == BYTE_ARRAY)
+				value = ByteArray();
+			else if (type == BYTE_STREAM)
+				value = std::shared_ptr<ByteStream>(nullptr);
+			else
+				value = std::string();
+		};
+
+		/**
+		 * @brief Kind of a number type; floating point, signed integer, unsigned integer or any other
+		 */
+		template <typename T>
+		using number_kind = std::integral_constant<int,
+			std::is_floating_point<T>::value == true ? 0 :
+			std::is_integral<T>::value == false ? 3 :
+			std::is_signed<T>::value == true ? 1 : 2>;
+
+		template <typename T>
+		static auto make_number(const T &val, std::integral_constant<int, 0>) -> value_type
+		{
+			return (double)val;
+		};
+		template <typename T>
+		static auto make_number(const T &val, std::integral_constant<int, 1>) -> value_type
+		{
+			return (long long)val;
+		};
+		template <typename T>
+		static auto make_number(const T &val, std::integral_constant<int, 2>) -> value_type
+		{
+			if ((unsigned long long)val <= (unsigned long long)LLONG_MAX)
+				return (long long)val;
+			else
+				return (unsigned long long)val;
+		};
+		template <typename T>
+		static auto make_number(const T &val, std::integral_constant<int, 3>) -> value_type
+		{
+			std::stringstream sstream;
+			sstream << val;
+
+			return parse_number(sstream.str());
+		};
+
+		static auto parse_number(const std::string &str) -> value_type
+		{
+			const char *first = str.c_str();
+			char *last;
+
+			// INTEGER, WITHOUT LOSS OF PRECISION
+			errno = 0;
+			long long integer = std::strtoll(first, &last, 10);
+			if (last != first && *last == '\0' && errno == 0)
+				return integer;
+
+			errno = 0;
+			unsigned long long natural = std::strtoull(first, &last, 10);
+			if (last != first && *last == '\0' && errno == 0 && str.front() != '-')
+				return natural;
+
+			// FLOATING POINT, OR AN INTEGER OVER RANGE OF 64 BITS
+			double real = std::strtod(first, &last);
+			if (last != first && *last == '\0')
+				return real;
+
+			// NOT A NUMBER, KEEP THE TEXT
+			return str;
+		};
+
+		template <typename T>
+		static auto cast_number(const value_type &value, T &val) -> bool
+		{
+			if (const long long *integer = boost::get<long long>(&value))
+				val = (T)*integer;
+			else if (const unsigned long long *natural = boost::get<unsigned long long>(&value))
+				val = (T)*natural;
+			else if (const double *real = boost::get<double>(&value))
+				val = (T)*real;
+			else
+				return false;
+
+			return true;
+		};
+
+		auto format_text() const -> std::string
+		{
+			if (const long long *integer = boost::get<long long>(&value))
+				return std::to_string(*integer);
+			else if (const unsigned long long *integer = boost::get<unsigned long long>(&value))
+				return std::to_string(*integer);
+			else if (const double *real = boost::get<double>(&value))
+				return format_number(*real);
+			else
+				return "";
+		};
+
+		auto refer_text() const -> const std::string&
+		{
+			if (const std::string *str = boost::get<std::string>(&value))
+				return *str;
+
+			// FORMAT A NUMBER ONCE
+			if (text.empty() == true)
+				text = format_text();
+			return text;
+		};
+
+		static auto format_number(double val) -> std::string
+		{
+			char buffer[32];
+
+			// SHORTEST OF THE TWO, WHICH RESTORES THE SAME DOUBLE
+			std::snprintf(buffer, sizeof(buffer), "%.15g", val);
+			if (std::strtod(buffer, nullptr) != val)
+				std::snprintf(buffer, sizeof(buffer), "%.17g", val);
+
+			return buffer;
 		};
 
 	public:
@@ -366,14 +634,26 @@ namespace protocol
 
 			if (name.empty() == false)
 				xml->setProperty("name", name);
-			xml->setProperty("type", type);
+			xml->setProperty("type", getType());
 
-			if (type == "XML")
-				xml->push_back(this->xml);
-			else if (type == "ByteArray")
-				xml->setValue(byte_array.size());
+			// NUMBERS ARE FORMATTED ONLY HERE
+			// EMPTY VALUES OF A TYPE-ONLY PARAMETER ARE NULL
+			if (type == XML)
+			{
+				std::shared_ptr<library::XML> child = getValueAsXML();
+				if (child != nullptr)
+					xml->push_back(child);
+			}
+			else if (type == BYTE_ARRAY)
+				xml->setValue(boost::get<ByteArray>(value).size());
+			else if (type == BYTE_STREAM)
+			{
+				const std::shared_ptr<ByteStream> &byte_stream = boost::get<std::shared_ptr<ByteStream>>(value);
+				if (byte_stream != nullptr)
+					xml->setValue(byte_stream->size());
+			}
 			else
-				xml->setValue(str);
+				xml->setValue(getValue<std::string>());
 
 			return xml;
 		};
@@ -0,0 +1,320 @@
+#pragma once
+#include <samchon/API.hpp>
+
+#include <samchon/protocol/Invoke.hpp>
+
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+namespace samchon
+{
+namespace protocol
+{
+	/**
+	 * A thread-local pool of {@link Invoke} messages and their {@link InvokeParameter parameters}.
+	 *
+	 * Each received message used to cost a heap allocation for the {@link Invoke}, one for each
+	 * {@link InvokeParameter}, one for each of their ```shared_ptr``` control blocks, and more for their strings and
+	 * containers. The {@link InvokePool} serves those objects from free lists instead. An object created by the pool
+	 * is not deleted when its last ```shared_ptr``` is released, but cleared and returned to the pool of the releasing
+	 * thread, keeping capacity of its strings and containers. Control blocks are recycled in the same way.
+	 *
+	 * Releasing an {@link Invoke} recycles the whole message graph: its parameters return to the pool when the message
+	 * drops them, unless they're still shared by another message.
+	 *
+	 * @code
+	 * protocol::InvokePool &pool = protocol::InvokePool::get();
+	 *
+	 * std::shared_ptr<protocol::Invoke> invoke = pool.createInvoke("setPiece");
+	 * invoke->push_back(pool.createParameter("first", first));
+	 * invoke->push_back(pool.createParameter("last", last));
+	 * @endcode
+	 *
+	 * Each thread has its own {@link InvokePool}, so that no lock is required. An object released by a thread other
+	 * than its creator migrates to the releasing thread's pool. Each pool caches a bounded number of objects; the rest
+	 * are deleted.
+	 *
+	 * @see {@link Invoke}, {@link InvokeParameter}, {@link InvokeCodec}
+	 * @author Jeongho Nam <http://samchon.org>
+	 */
+	class InvokePool
+	{
+	public:
+		enum : size_t
+		{
+			/**
+			 * Maximum number of {@link Invoke} objects cached per thread.
+			 */
+			INVOKE_CAPACITY = 1024,
+
+			/**
+			 * Maximum number of {@link InvokeParameter} objects cached per thread.
+			 */
+			PARAMETER_CAPACITY = 4096,
+
+			/**
+			 * Size of a pooled control block.
+			 */
+			CONTROL_BLOCK_SIZE = 64
+		};
+
+	private:
+		std::vector<Invoke*> invokes;
+		std::vector<InvokeParameter*> parameters;
+		std::vector<void*> blocks;
+
+		template <typename T> class BlockAllocator;
+		struct InvokeDeleter;
+		struct ParameterDeleter;
+
+	public:
+		/* ---------------------------------------------------------
+			CONSTRUCTORS
+		--------------------------------------------------------- */
+		/**
+		 * Get pool of the current thread.
+		 */
+		static auto get() -> InvokePool&
+		{
+			thread_local InvokePool pool;
+			return pool;
+		};
+
+		~InvokePool()
+		{
+			// OBJECTS RELEASED AFTER THIS POINT ARE DELETED DIRECTLY
+			destructed() = true;
+
+			for (size_t i = 0; i < invokes.size(); i++)
+				delete invokes[i];
+			for (size_t i = 0; i < parameters.size(); i++)
+				delete parameters[i];
+			for (size_t i = 0; i < blocks.size(); i++)
+				::operator delete(blocks[i]);
+		};
+
+		/* ---------------------------------------------------------
+			FACTORIES
+		--------------------------------------------------------- */
+		/**
+		 * Create an {@link Invoke} message.
+		 *
+		 * @param listener Listener of the message.
+		 * @return An empty {@link Invoke} message, which returns to the pool when released.
+		 */
+		auto createInvoke(const std::string &listener = "") -> std::shared_ptr<Invoke>
+		{
+			Invoke *invoke;
+			if (invokes.empty() == true)
+				invoke = new Invoke();
+			else
+			{
+				invoke = invokes.back();
+				invokes.pop_back();
+			}
+			invoke->listener = listener;
+
+			return std::shared_ptr<Invoke>(invoke, InvokeDeleter(), BlockAllocator<Invoke>());
+		};
+
+		/**
+		 * Create an empty {@link InvokeParameter}.
+		 *
+		 * @return An {@link InvokeParameter} of an empty string, which returns to the pool when released.
+		 */
+		auto createParameter() -> std::shared_ptr<InvokeParameter>
+		{
+			InvokeParameter *parameter;
+			if (parameters.empty() == true)
+				parameter = new InvokeParameter();
+			else
+			{
+				parameter = parameters.back();
+				parameters.pop_back();
+			}
+			return std::shared_ptr<InvokeParameter>(parameter, ParameterDeleter(), BlockAllocator<InvokeParameter>());
+		};
+
+		/**
+		 * Create an {@link InvokeParameter} with its name and a value.
+		 *
+		 * Type of the parameter is determined automatically, as the {@link InvokeParameter} constructor does.
+		 *
+		 * @param name Name of the parameter.
+		 * @param val Value of the parameter.
+		 */
+		template <typename T>
+		auto createParameter(const std::string &name, const T &val) -> std::shared_ptr<InvokeParameter>
+		{
+			std::shared_ptr<InvokeParameter> parameter = createParameter();
+			parameter->name = name;
+			parameter->construct_by_varadic_template(val);
+
+			return parameter;
+		};
+
+		auto createParameter(const std::string &name, const char *val) -> std::shared_ptr<InvokeParameter>
+		{
+			return createParameter(name, std::string(val));
+		};
+
+		/* ---------------------------------------------------------
+			ACCESSORS
+		--------------------------------------------------------- */
+		/**
+		 * Get number of cached {@link Invoke} objects.
+		 */
+		auto cachedInvokes() const -> size_t
+		{
+			return invokes.size();
+		};
+
+		/**
+		 * Get number of cached {@link InvokeParameter} objects.
+		 */
+		auto cachedParameters() const -> size_t
+		{
+			return parameters.size();
+		};
+
+	private:
+		/* ---------------------------------------------------------
+			RECYCLE
+		--------------------------------------------------------- */
+		static auto destructed() -> bool&
+		{
+			thread_local bool flag = false;
+			return flag;
+		};
+
+		void recycle(Invoke *invoke)
+		{
+			// PARAMETERS RETURN BY THEIR OWN DELETERS
+			invoke->clear();
+			invoke->listener.clear();
+			invoke->call_uid = 0;
+
+			if (invoke->capacity() > 64)
+				invoke->shrink_to_fit();
+
+			if (invokes.size() < INVOKE_CAPACITY)
+				invokes.push_back(invoke);
+			else
+				delete invoke;
+		};
+
+		void recycle(InvokeParameter *parameter)
+		{
+			if (parameters.size() == PARAMETER_CAPACITY)
+			{
+				delete parameter;
+				return;
+			}
+
+			parameter->name.clear();
+			parameter->type = InvokeParameter::STRING;
+			parameter->custom_type.clear();
+			parameter->text.clear();
+
+			// KEEP A STRING'S CAPACITY, RELEASE OTHERS
+			std::string *str = boost::get<std::string>(&parameter->value);
+			if (str != nullptr && str->capacity() <= 1024)
+				str->clear();
+			else
+				parameter->value = std::string();
+
+			parameters.push_back(parameter);
+		};
+
+		auto allocate_block(size_t size) -> void*
+		{
+			if (size > CONTROL_BLOCK_SIZE)
+				return ::operator new(size);
+			else if (blocks.empty() == true)
+				return ::operator new(CONTROL_BLOCK_SIZE);
+
+			void *block = blocks.back();
+			blocks.pop_back();
+
+			return block;
+		};
+
+		void deallocate_block(void *block, size_t size)
+		{
+			if (size <= CONTROL_BLOCK_SIZE && blocks.size() < INVOKE_CAPACITY + PARAMETER_CAPACITY)
+				blocks.push_back(block);
+			else
+				::operator delete(block);
+		};
+
+		/* ---------------------------------------------------------
+			DELETERS AND ALLOCATOR OF CONTROL BLOCKS
+		--------------------------------------------------------- */
+		struct InvokeDeleter
+		{
+			void operator()(Invoke *invoke) const
+			{
+				if (destructed() == true)
+					delete invoke;
+				else
+					get().recycle(invoke);
+			};
+		};
+
+		struct ParameterDeleter
+		{
+			void operator()(InvokeParameter *parameter) const
+			{
+				if (destructed() == true)
+					delete parameter;
+				else
+					get().recycle(parameter);
+			};
+		};
+
+		template <typename T>
+		class BlockAllocator
+		{
+		public:
+			typedef T value_type;
+
+			BlockAllocator() = default;
+
+			template <typename U>
+			BlockAllocator(const BlockAllocator<U> &)
+			{
+			};
+
+			auto allocate(size_t n) -> T*
+			{
+				if (destructed() == true)
+					return (T*)::operator new(n * sizeof(T));
+				else
+					return (T*)get().allocate_block(n * sizeof(T));
+			};
+
+			void deallocate(T *ptr, size_t n)
+			{
+				if (destructed() == true)
+					::operator delete(ptr);
+				else
+					get().deallocate_block(ptr, n * sizeof(T));
+			};
+
+			template <typename U>
+			auto operator==(const BlockAllocator<U> &) const -> bool
+			{
+				return true;
+			};
+
+			template <typename U>
+			auto operator!=(const BlockAllocator<U> &) const -> bool
+			{
+				return false;
+			};
+		};
+	};
+};
+};
@@ -0,0 +1,201 @@
+#pragma once
+#include <samchon/API.hpp>
+
+#include <samchon/protocol/Invoke.hpp>
+
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+
+namespace samchon
+{
+namespace protocol
+{
+	/**
+	 * Decoder of an {@link InvokeParameter} to an argument of a typed listener.
+	 *
+	 * Values follow {@link InvokeParameter.getValue InvokeParameter.getValue()}, which converts a number from its
+	 * native form. Strings and *ByteArray* can be referenced or moved, without copying. A number can be taken as a string
+	 * too, by its text.
+	 *
+	 * @tparam T Type of the argument.
+	 */
+	template <typename T, typename Enable = void>
+	struct ListenerParameter
+	{
+		static auto decode(InvokeParameter &parameter) -> typename std::decay<T>::type
+		{
+			return parameter.getValue<typename std::decay<T>::type>();
+		};
+	};
+
+	template <>
+	struct ListenerParameter<const std::string&>
+	{
+		static auto decode(InvokeParameter &parameter) -> const std::string&
+		{
+			// A NUMBER IS REFERRED BY ITS TEXT, SAME WITH getValue<std::string>()
+			return parameter.referValue<std::string>();
+		};
+	};
+
+	template <>
+	struct ListenerParameter<const ByteArray&>
+	{
+		static auto decode(InvokeParameter &parameter) -> const ByteArray&
+		{
+			return parameter.referValue<ByteArray>();
+		};
+	};
+
+	template <>
+	struct ListenerParameter<ByteArray>
+	{
+		static auto decode(InvokeParameter &parameter) -> ByteArray
+		{
+			// THE LISTENER IS THE LAST ONE TO HANDLE THE MESSAGE
+			return parameter.moveValue<ByteArray>();
+		};
+	};
+
+	template <>
+	struct ListenerParameter<std::shared_ptr<library::XML>>
+	{
+		static auto decode(InvokeParameter &parameter) -> std::shared_ptr<library::XML>
+		{
+			return parameter.getValueAsXML();
+		};
+	};
+
+	/**
+	 * A registry of listeners.
+	 *
+	 * The {@link ListenerRegistry} maps names of {@link Invoke.getListener listeners} to their handlers in a hash map.
+	 * It replaces a chain of ```invoke->getListener() == "..."``` comparisons in {@link IProtocol.replyData replyData()}
+	 * by a single lookup, whose cost doesn't grow with number of the listeners.
+	 *
+	 * A typed handler, registered by {@link on on<Args...>()}, gets parameters of the {@link Invoke} message decoded
+	 * into its arguments, in order. An argument can be a number, ```std::string```, {@link WeakString},
+	 * *ByteArray*, ```std::shared_ptr<library::XML>``` or ```std::shared_ptr<ByteStream>```. A *ByteArray* argument
+	 * takes content of the parameter by move; declare it as ```const ByteArray&``` to refer it instead. A handler
+	 * getting the {@link Invoke} message itself is registered by {@link onInvoke onInvoke()}.
+	 *
+	 * @code
+	 * protocol::ListenerRegistry listeners;
+	 * listeners.on<int, std::string, ByteArray>("upload", [this](int uid, std::string name, ByteArray data)
+	 * {
+	 *	   save(uid, name, std::move(data));
+	 * });
+	 *
+	 * virtual void replyData(std::shared_ptr<protocol::Invoke> invoke) override
+	 * {
+	 *	   if (listeners.dispatch(invoke) == false)
+	 *		   ...; // UNKNOWN LISTENER
+	 * }
+	 * @endcode
+	 *
+	 * Register handlers before messages arrive. {@link dispatch dispatch()} can be called from multiple threads
+	 * concurrently, but not with {@link on on()}, {@link onInvoke onInvoke()} or {@link erase erase()}.
+	 *
+	 * @see {@link Invoke}, {@link IProtocol}
+	 * @author Jeongho Nam <http://samchon.org>
+	 */
+	class ListenerRegistry
+	{
+	private:
+		std::unordered_map<std::string, std::function<void(std::shared_ptr<Invoke>)>> handlers;
+
+	public:
+		/* ---------------------------------------------------------
+			REGISTRATION
+		--------------------------------------------------------- */
+		/**
+		 * Register a typed handler.
+		 *
+		 * @tparam Args Types of the parameters, in order.
+		 * @param listener Name of the listener.
+		 * @param handler A function taking the parameters as *Args*. It replaces a handler of the same *listener*.
+		 * @throw invalid_argument On dispatching, if the {@link Invoke} message has fewer parameters than *Args*.
+		 */
+		template <typename ... Args, typename Handler>
+		void on(const std::string &listener, Handler handler)
+		{
+			handlers[listener] = [listener, handler](std::shared_ptr<Invoke> invoke)
+			{
+				if (invoke->size() < sizeof...(Args))
+					throw std::invalid_argument("too few parameters for the listener: " + listener);
+
+				call(handler, *invoke, (std::tuple<Args...>*)nullptr, std::index_sequence_for<Args...>());
+			};
+		};
+
+		/**
+		 * Register a handler of the {@link Invoke} message itself.
+		 *
+		 * @param listener Name of the listener.
+		 * @param handler A function taking the {@link Invoke} message. It replaces a handler of the same *listener*.
+		 */
+		void onInvoke(const std::string &listener, std::function<void(std::shared_ptr<Invoke>)> handler)
+		{
+			handlers[listener] = handler;
+		};
+
+		/**
+		 * Remove a handler.
+		 *
+		 * @param listener Name of the listener.
+		 */
+		void erase(const std::string &listener)
+		{
+			handlers.erase(listener);
+		};
+
+		/**
+		 * Test whether a handler of the *listener* is registered.
+		 */
+		auto has(const std::string &listener) const -> bool
+		{
+			return handlers.find(listener) != handlers.end();
+		};
+
+		/**
+		 * Get number of the registered handlers.
+		 */
+		auto size() const -> size_t
+		{
+			return handlers.size();
+		};
+
+		/* ---------------------------------------------------------
+			DISPATCH
+		--------------------------------------------------------- */
+		/**
+		 * Dispatch an {@link Invoke} message to its handler.
+		 *
+		 * @param invoke An {@link Invoke} message received.
+		 * @return Whether a handler of the message's listener is registered, and has handled it.
+		 */
+		auto dispatch(std::shared_ptr<Invoke> invoke) const -> bool
+		{
+			auto it = handlers.find(invoke->referListener());
+			if (it == handlers.end())
+				return false;
+
+			it->second(invoke);
+			return true;
+		};
+
+	private:
+		template <typename Handler, typename ... Args, size_t ... I>
+		static void call(const Handler &handler, Invoke &invoke, std::tuple<Args...>*, std::index_sequence<I...>)
+		{
+			handler(ListenerParameter<Args>::decode(*invoke.at(I))...);
+		};
+	};
+};
+};
@@ -0,0 +1,242 @@
+#pragma once
+#include <samchon/API.hpp>
+
+#include <samchon/protocol/ClientDriver.hpp>
+#include <samchon/protocol/LoopbackSocket.hpp>
+
+#include <deque>
+#include <utility>
+
+namespace samchon
+{
+namespace protocol
+{
+	/**
+	 * A communicator connected to its peer in memory.
+	 *
+	 * The {@link LoopbackCommunicator} connects two {@link IProtocol} endpoints in a process, without any socket of the
+	 * system. It's for testing and benchmarking systems built on the {@link Communicator}, like the templates of
+	 * parallel processing, deterministically on a machine.
+	 *
+	 * A connected pair is created by {@link pair pair()}. As a {@link ClientDriver}, an end can be delivered to a
+	 * {@link Server} by {@link Server.accept Server.accept()}, as if a client had connected, and the other end plays
+	 * the client.
+	 *
+	 * @code
+	 * auto ends = protocol::LoopbackCommunicator::pair();
+	 * server->accept(ends.first);
+	 *
+	 * std::thread([&]() { ends.second->listen(&client); }).detach();
+	 * ends.second->sendData(std::make_shared<protocol::Invoke>("setData", 3));
+	 * @endcode
+	 *
+	 * Messages are delivered in one of two modes.
+	 *
+	 * - **Encoded**: messages are encoded, written to a {@link LoopbackSocket} and decoded, by the same code as a
+	 *   TCP connection. It measures everything but the system's network stack.
+	 * - **Direct**: {@link Invoke} objects are handed over to the peer as they are, not encoded. It measures the
+	 *   systems themselves, excluding costs of the protocol.
+	 *
+	 * In the direct mode, the receiver gets a shallow copy of the {@link Invoke} object sent, a new {@link Invoke}
+	 * sharing its parameters. Adding or removing parameters on either side doesn't affect the other, but don't modify
+	 * values of the parameters after sending, as *ByteArray* contents. {@link ByteStream} parameters are not supported; sending them fails with
+	 * ```boost::asio::error::operation_not_supported```. Messages sent before the peer starts to listen are held, and
+	 * delivered in order when it starts. In the blocking mode, messages are delivered from the sending thread; a
+	 * message sent while the peer is handling another is queued and delivered by the thread handling, so that the
+	 * peer handles one message at a time, as a connection does. In the asynchronous mode, messages are delivered
+	 * from the peer's strand.
+	 *
+	 * @see {@link LoopbackSocket}, {@link Server.accept}
+	 * @author Jeongho Nam <http://samchon.org>
+	 */
+	class LoopbackCommunicator
+		: public ClientDriver
+	{
+	private:
+		bool encoded;
+		std::weak_ptr<LoopbackCommunicator> peer;
+
+		// MESSAGES OF THE DIRECT MODE, NOT DELIVERED YET
+		std::mutex inbox_mutex;
+		std::deque<std::shared_ptr<Invoke>> inbox;
+		bool listening;
+		bool delivering;
+
+		Metrics::Counter *messages_out;
+
+	public:
+		/* ---------------------------------------------------------
+			CONSTRUCTORS
+		--------------------------------------------------------- */
+		/**
+		 * Create a connected pair.
+		 *
+		 * @param encoded Whether to deliver messages through the encoder, or to hand over {@link Invoke} objects directly.
+		 * @param pool Reactor of the asynchronous mode, ```nullptr``` for the blocking mode.
+		 * @return The two ends.
+		 */
+		static auto pair(bool encoded = false, std::shared_ptr<IOServicePool> pool = nullptr)
+			-> std::pair<std::shared_ptr<LoopbackCommunicator>, std::shared_ptr<LoopbackCommunicator>>
+		{
+			auto sockets = (pool == nullptr)
+				? LoopbackSocket::pair()
+				: LoopbackSocket::pair(&pool->getService(), &pool->getService());
+
+			std::shared_ptr<LoopbackCommunicator> first(new LoopbackCommunicator(sockets.first, encoded));
+			std::shared_ptr<LoopbackCommunicator> second(new LoopbackCommunicator(sockets.second, encoded));
+
+			first->peer = second;
+			second->peer = first;
+
+			if (pool != nullptr)
+			{
+				first->set_service_pool(pool);
+				second->set_service_pool(pool);
+			}
+			return {first, second};
+		};
+
+	private:
+		LoopbackCommunicator(std::shared_ptr<LoopbackSocket> socket, bool encoded)
+			: Communicator(),
+			ClientDriver(socket)
+		{
+			this->encoded = encoded;
+
+			listening = false;
+			delivering = false;
+
+			messages_out = &getMetrics().counter("messages.out");
+		};
+
+	public:
+		virtual ~LoopbackCommunicator() = default;
+
+		/**
+		 * Test whether messages are delivered through the encoder.
+		 */
+		auto isEncoded() const -> bool
+		{
+			return encoded;
+		};
+
+	protected:
+		/* ---------------------------------------------------------
+			DIRECT MODE
+		--------------------------------------------------------- */
+		virtual auto enqueue_message(std::shared_ptr<Invoke> invoke, std::function<void(const boost::system::error_code&)> callback) -> bool override
+		{
+			if (encoded == true)
+				return ClientDriver::enqueue_message(invoke, callback);
+
+			boost::system::error_code error;
+			std::shared_ptr<LoopbackCommunicator> peer = this->peer.lock();
+
+			if (has_stream(*invoke) == true)
+				error = boost::asio::error::operation_not_supported;
+			else if (peer == nullptr || socket->is_open() == false)
+				error = boost::asio::error::not_connected;
+			else
+			{
+				peer->post_message(copy_message(*invoke));
+				messages_out->fetch_add(1, std::memory_order_relaxed);
+			}
+
+			if (callback != nullptr)
+				callback(error);
+
+			// NOTHING TO WRITE
+			return false;
+		};
+
+		virtual auto handle_buffered_frames(size_t &remainder) -> bool override
+		{
+			if (encoded == true)
+				return ClientDriver::handle_buffered_frames(remainder);
+
+			// STARTS LISTENING, THEN DELIVER MESSAGES HELD
+			{
+				std::unique_lock<std::mutex> uk(inbox_mutex);
+				listening = true;
+			}
+			deliver_messages();
+
+			// NO BYTE ARRIVES, UNTIL THE PEER CLOSES
+			remainder = 0;
+			return true;
+		};
+
+	private:
+		void post_message(std::shared_ptr<Invoke> invoke)
+		{
+			{
+				std::unique_lock<std::mutex> uk(inbox_mutex);
+				inbox.push_back(invoke);
+
+				if (listening == false)
+					return;
+			}
+
+			if (strand == nullptr)
+				deliver_messages();
+			else
+			{
+				std::shared_ptr<Communicator> self = shared_from_this();
+				strand->post([this, self]()
+				{
+					deliver_messages();
+				});
+			}
+		};
+
+		void deliver_messages()
+		{
+			while (true)
+			{
+				std::shared_ptr<Invoke> invoke;
+				{
+					// ANOTHER THREAD IS DELIVERING, THEN IT DELIVERS THE MESSAGE TOO
+					std::unique_lock<std::mutex> uk(inbox_mutex);
+					if (delivering == true || inbox.empty() == true)
+						return;
+
+					invoke = inbox.front();
+					inbox.pop_front();
+					delivering = true;
+				}
+
+				std::exception_ptr error;
+				try
+				{
+					reply_invoke(invoke);
+				}
+				catch (...)
+				{
+					error = std::current_exception();
+				}
+
+				{
+					std::unique_lock<std::mutex> uk(inbox_mutex);
+					delivering = false;
+				}
+
+				// AS THE LISTENING THREAD OF A CONNECTION DOES
+				if (error != nullptr)
+				{
+					handle_close(error);
+					return;
+				}
+			}
+		};
+
+		static auto has_stream(const Invoke &invoke) -> bool
+		{
+			for (size_t i = 0; i < invoke.size(); i++)
+				if (invoke.at(i)->getTypeCode() == InvokeParameter::BYTE_STREAM)
+					return true;
+
+			return false;
+		};
+	};
+};
+};
@@ -0,0 +1,281 @@
+#pragma once
+#include <samchon/API.hpp>
+
+#include <samchon/protocol/Socket.hpp>
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <utility>
+
+namespace samchon
+{
+namespace protocol
+{
+	/**
+	 * A {@link Socket} connected to its peer in memory.
+	 *
+	 * A pair of {@link LoopbackSocket} objects, created by {@link pair pair()}, are the two ends of a byte stream in
+	 * a process, without any socket of the system. Bytes written to one end are read from the other end, as they are
+	 * written. Writing never blocks; bytes not read yet are held by the reading end, unboundedly.
+	 *
+	 * Closing an end makes the other end reach end of the stream, after it has read the bytes written before.
+	 *
+	 * @see {@link LoopbackCommunicator}
+	 * @author Jeongho Nam <http://samchon.org>
+	 */
+	class LoopbackSocket
+		: public Socket
+	{
+	private:
+		// BYTES OF A DIRECTION, FROM THE WRITING END TO THE READING END
+		struct Pipe
+		{
+			std::mutex mutex;
+			std::condition_variable cv;
+
+			std::vector<unsigned char> data;
+			size_t first;
+
+			// CLOSED BY THE WRITING END, AND BY THE READING END
+			bool eof;
+			bool aborted;
+
+			// AN ASYNCHRONOUS READ WAITING FOR BYTES
+			boost::asio::mutable_buffer buffer;
+			Handler handler;
+			std::unique_ptr<executor_type> executor;
+
+			Pipe()
+			{
+				first = 0;
+				eof = false;
+				aborted = false;
+			};
+
+			auto read(boost::asio::mutable_buffer buffer) -> size_t
+			{
+				size_t size = std::min(buffer.size(), data.size() - first);
+				std::memcpy(buffer.data(), data.data() + first, size);
+
+				first += size;
+				if (first == data.size())
+				{
+					data.clear();
+					first = 0;
+				}
+				else if (first >= 64 * 1024 && first >= data.size() / 2)
+				{
+					// READ PARTIALLY WHILE BYTES ARE ARRIVING
+					data.erase(data.begin(), data.begin() + first);
+					first = 0;
+				}
+				return size;
+			};
+
+			// THE PENDING READ, COMPLETED WHEN BYTES ARRIVE OR THE PIPE IS CLOSED
+			auto complete(std::function<void()> &completion) -> bool
+			{
+				if (handler == nullptr || (data.size() == first && eof == false && aborted == false))
+					return false;
+
+				boost::system::error_code error;
+				size_t size = 0;
+
+				if (aborted == true)
+					error = boost::asio::error::operation_aborted;
+				else if (data.size() != first)
+					size = read(buffer);
+				else
+					error = boost::asio::error::eof;
+
+				Handler handler = std::move(this->handler);
+				this->handler = nullptr;
+
+				executor_type executor = *this->executor;
+				completion = [executor, handler, error, size]()
+				{
+					boost::asio::post(executor, [handler, error, size]()
+					{
+						handler(error, size);
+					});
+				};
+				return true;
+			};
+		};
+
+		std::shared_ptr<boost::asio::io_service> io_service;
+		executor_type executor;
+
+		std::shared_ptr<Pipe> input;
+		std::shared_ptr<Pipe> output;
+
+	public:
+		/* ---------------------------------------------------------
+			CONSTRUCTORS
+		--------------------------------------------------------- */
+		/**
+		 * Create a connected pair.
+		 *
+		 * Asynchronous operations of the first end are completed by the *first* service, and those of the second end by
+		 * the *second*. Each end owns a service of its own if not specified, for an end used in the blocking mode.
+		 *
+		 * @param first An ```io_service``` completing asynchronous operations of the first end.
+		 * @param second An ```io_service``` completing asynchronous operations of the second end.
+		 * @return The two ends.
+		 */
+		static auto pair(boost::asio::io_service *first = nullptr, boost::asio::io_service *second = nullptr)
+			-> std::pair<std::shared_ptr<LoopbackSocket>, std::shared_ptr<LoopbackSocket>>
+		{
+			std::shared_ptr<Pipe> forward(new Pipe());
+			std::shared_ptr<Pipe> backward(new Pipe());
+
+			return
+			{
+				std::shared_ptr<LoopbackSocket>(new LoopbackSocket(first, backward, forward)),
+				std::shared_ptr<LoopbackSocket>(new LoopbackSocket(second, forward, backward))
+			};
+		};
+
+	private:
+		LoopbackSocket(boost::asio::io_service *service, std::shared_ptr<Pipe> input, std::shared_ptr<Pipe> output)
+			: io_service((service == nullptr) ? new boost::asio::io_service() : nullptr),
+			executor((service == nullptr) ? io_service->get_executor() : service->get_executor()),
+			input(input),
+			output(output)
+		{
+		};
+
+	public:
+		virtual ~LoopbackSocket()
+		{
+			boost::system::error_code error;
+			close(error);
+		};
+
+		virtual void close(boost::system::error_code &error) override
+		{
+			std::function<void()> completion;
+
+			// THE PEER READS TO THE END
+			{
+				std::unique_lock<std::mutex> uk(output->mutex);
+				output->eof = true;
+				output->complete(completion);
+			}
+			output->cv.notify_all();
+			if (completion != nullptr)
+				completion();
+
+			// NOTHING IS READ ANYMORE
+			completion = nullptr;
+			{
+				std::unique_lock<std::mutex> uk(input->mutex);
+				input->aborted = true;
+				input->complete(completion);
+			}
+			input->cv.notify_all();
+			if (completion != nullptr)
+				completion();
+		};
+
+		/* ---------------------------------------------------------
+			ACCESSORS
+		--------------------------------------------------------- */
+		virtual auto get_executor() -> executor_type override
+		{
+			return executor;
+		};
+
+		virtual auto is_open() const -> bool override
+		{
+			std::unique_lock<std::mutex> uk(input->mutex);
+			return input->aborted == false;
+		};
+
+	protected:
+		/* ---------------------------------------------------------
+			TRANSPORT
+		--------------------------------------------------------- */
+		virtual auto read_bytes(boost::asio::mutable_buffer buffer, boost::system::error_code &error) -> size_t override
+		{
+			std::unique_lock<std::mutex> uk(input->mutex);
+			input->cv.wait(uk, [this]()
+			{
+				return input->data.size() != input->first || input->eof == true || input->aborted == true;
+			});
+
+			if (input->aborted == true)
+				error = boost::asio::error::operation_aborted;
+			else if (input->data.size() != input->first)
+				return input->read(buffer);
+			else
+				error = boost::asio::error::eof;
+
+			return 0;
+		};
+
+		virtual void async_read_bytes(boost::asio::mutable_buffer buffer, Handler handler) override
+		{
+			std::function<void()> completion;
+			{
+				std::unique_lock<std::mutex> uk(input->mutex);
+
+				input->buffer = buffer;
+				input->handler = std::move(handler);
+				input->executor.reset(new executor_type(executor));
+
+				input->complete(completion);
+			}
+			if (completion != nullptr)
+				completion();
+		};
+
+		virtual auto write_bytes(const boost::asio::const_buffer *buffers, size_t count, boost::system::error_code &error) -> size_t override
+		{
+			std::function<void()> completion;
+			size_t size = 0;
+			{
+				std::unique_lock<std::mutex> uk(output->mutex);
+				if (output->eof == true)
+				{
+					error = boost::asio::error::operation_aborted;
+					return 0;
+				}
+				else if (output->aborted == true)
+				{
+					error = boost::asio::error::broken_pipe;
+					return 0;
+				}
+
+				for (size_t i = 0; i < count; i++)
+				{
+					const unsigned char *data = (const unsigned char*)buffers[i].data();
+					output->data.insert(output->data.end(), data, data + buffers[i].size());
+
+					size += buffers[i].size();
+				}
+				output->complete(completion);
+			}
+			output->cv.notify_one();
+			if (completion != nullptr)
+				completion();
+
+			return size;
+		};
+
+		virtual void async_write_bytes(std::vector<boost::asio::const_buffer> buffers, Handler handler) override
+		{
+			// WRITING NEVER BLOCKS
+			boost::system::error_code error;
+			size_t size = write_bytes(buffers.data(), buffers.size(), error);
+
+			boost::asio::post(executor, [handler, error, size]()
+			{
+				handler(error, size);
+			});
+		};
+	};
+};
+};
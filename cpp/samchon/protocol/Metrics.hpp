@@ -0,0 +1,280 @@
+#pragma once
+#include <samchon/API.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <map>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <samchon/library/Histogram.hpp>
+#include <samchon/library/XML.hpp>
+
+namespace samchon
+{
+namespace protocol
+{
+	/**
+	 * A registry of metrics.
+	 *
+	 * The {@link Metrics} holds named counters, gauges and {@link library::Histogram histograms}. A counter or a
+	 * histogram is created when it's referred first, and lives as long as the {@link Metrics}, so that a reference to
+	 * it can be kept and updated without looking it up again. Updating is a relaxed atomic operation; looking up takes
+	 * a shared lock, and an exclusive lock only on creation. A gauge is a function, evaluated when it's read.
+	 *
+	 * The {@link Communicator}, {@link templates::parallel::ParallelSystem} and {@link templates::slave::SlaveSystem}
+	 * have their own {@link Metrics}. Those of a {@link Communicator} and its listener can be queried by the remote
+	 * system too, by an {@link Invoke} message of the {@link QUERY_LISTENER} ```_Metrics```. The reply, of the
+	 * {@link REPORT_LISTENER} ```_Report_metrics```, has an {@link library::XML XML} parameter from {@link toXML}. A
+	 * query sent by {@link Communicator.call Communicator.call()} gets the reply as its result.
+	 *
+	 * @see {@link Communicator.getMetrics}, {@link library::Histogram}
+	 * @author Jeongho Nam <http://samchon.org>
+	 */
+	class Metrics
+	{
+	public:
+		/**
+		 * A counter.
+		 */
+		typedef std::atomic<unsigned long long> Counter;
+
+		/**
+		 * A function reading the current value of a gauge.
+		 */
+		typedef std::function<unsigned long long()> Gauge;
+
+	private:
+		mutable std::shared_mutex mtx;
+
+		std::map<std::string, std::unique_ptr<Counter>> counters;
+		std::map<std::string, Gauge> gauges;
+		std::map<std::string, std::unique_ptr<library::Histogram>> histograms;
+
+		std::atomic<std::chrono::steady_clock::rep> reset_time;
+
+	public:
+		/* ---------------------------------------------------------
+			CONSTRUCTORS
+		--------------------------------------------------------- */
+		/**
+		 * Default Constructor.
+		 */
+		Metrics()
+		{
+			reset_time = std::chrono::steady_clock::now().time_since_epoch().count();
+		};
+		Metrics(const Metrics &) = delete;
+
+		/**
+		 * Listener of an {@link Invoke} message querying metrics of the remote system.
+		 */
+		static auto QUERY_LISTENER() -> const std::string&
+		{
+			static const std::string name = "_Metrics";
+			return name;
+		};
+
+		/**
+		 * Listener of an {@link Invoke} message replying metrics to the {@link QUERY_LISTENER query}.
+		 */
+		static auto REPORT_LISTENER() -> const std::string&
+		{
+			static const std::string name = "_Report_metrics";
+			return name;
+		};
+
+		/**
+		 * Clear counters and histograms.
+		 *
+		 * Gauges are kept. The {@link getElapsedTime elapsed time} starts again.
+		 */
+		void reset()
+		{
+			std::shared_lock<std::shared_mutex> uk(mtx);
+
+			for (auto it = counters.begin(); it != counters.end(); it++)
+				it->second->store(0, std::memory_order_relaxed);
+			for (auto it = histograms.begin(); it != histograms.end(); it++)
+				it->second->reset();
+
+			reset_time = std::chrono::steady_clock::now().time_since_epoch().count();
+		};
+
+		/* ---------------------------------------------------------
+			REGISTRATION
+		--------------------------------------------------------- */
+		/**
+		 * Get a counter, created if not exists.
+		 *
+		 * @param name Name of the counter.
+		 * @return The counter, valid as long as the {@link Metrics}.
+		 */
+		auto counter(const std::string &name) -> Counter&
+		{
+			{
+				std::shared_lock<std::shared_mutex> uk(mtx);
+
+				auto it = counters.find(name);
+				if (it != counters.end())
+					return *it->second;
+			}
+
+			std::unique_lock<std::shared_mutex> uk(mtx);
+			std::unique_ptr<Counter> &counter = counters[name];
+
+			if (counter == nullptr)
+				counter.reset(new Counter(0));
+			return *counter;
+		};
+
+		/**
+		 * Get a histogram, created if not exists.
+		 *
+		 * @param name Name of the histogram.
+		 * @return The histogram, valid as long as the {@link Metrics}.
+		 */
+		auto histogram(const std::string &name) -> library::Histogram&
+		{
+			library::Histogram *histogram = findHistogram(name);
+			if (histogram != nullptr)
+				return *histogram;
+
+			std::unique_lock<std::shared_mutex> uk(mtx);
+			std::unique_ptr<library::Histogram> &ptr = histograms[name];
+
+			if (ptr == nullptr)
+				ptr.reset(new library::Histogram());
+			return *ptr;
+		};
+
+		/**
+		 * Register a gauge.
+		 *
+		 * The *gauge* is called when the gauge is read, from the reading thread. A gauge of the same name is replaced.
+		 *
+		 * @param name Name of the gauge.
+		 * @param gauge A function reading the current value.
+		 */
+		void gauge(const std::string &name, Gauge gauge)
+		{
+			std::unique_lock<std::shared_mutex> uk(mtx);
+			gauges[name] = gauge;
+		};
+
+		/* ---------------------------------------------------------
+			ACCESSORS
+		--------------------------------------------------------- */
+		/**
+		 * Find a histogram.
+		 *
+		 * @param name Name of the histogram.
+		 * @return The histogram, ```nullptr``` if not exists.
+		 */
+		auto findHistogram(const std::string &name) const -> library::Histogram*
+		{
+			std::shared_lock<std::shared_mutex> uk(mtx);
+
+			auto it = histograms.find(name);
+			return (it == histograms.end()) ? nullptr : it->second.get();
+		};
+
+		/**
+		 * Get value of a counter.
+		 *
+		 * @param name Name of the counter.
+		 * @return The value, zero if the counter not exists.
+		 */
+		auto getCounter(const std::string &name) const -> unsigned long long
+		{
+			std::shared_lock<std::shared_mutex> uk(mtx);
+
+			auto it = counters.find(name);
+			return (it == counters.end()) ? 0 : it->second->load(std::memory_order_relaxed);
+		};
+
+		/**
+		 * Get current value of a gauge.
+		 *
+		 * @param name Name of the gauge.
+		 * @return The value, zero if the gauge not exists.
+		 */
+		auto getGauge(const std::string &name) const -> unsigned long long
+		{
+			Gauge gauge;
+			{
+				std::shared_lock<std::shared_mutex> uk(mtx);
+
+				auto it = gauges.find(name);
+				if (it == gauges.end())
+					return 0;
+				gauge = it->second;
+			}
+			return gauge();
+		};
+
+		/**
+		 * Get seconds elapsed since construction or the last {@link reset}, to get rates from counters.
+		 */
+		auto getElapsedTime() const -> double
+		{
+			std::chrono::steady_clock::duration elapsed = std::chrono::steady_clock::now().time_since_epoch() - std::chrono::steady_clock::duration(reset_time.load());
+			return std::chrono::duration<double>(elapsed).count();
+		};
+
+		/* ---------------------------------------------------------
+			EXPORTERS
+		--------------------------------------------------------- */
+		/**
+		 * Get an {@link library::XML XML} representing the {@link Metrics}.
+		 *
+		 * The {@link library::XML XML} has the {@link getElapsedTime elapsed time} as its property, and the counters,
+		 * gauges and histograms as its children, each with its name.
+		 *
+		 * @param tag Tag name of the {@link library::XML XML}.
+		 */
+		auto toXML(const std::string &tag = "metrics") const -> std::shared_ptr<library::XML>
+		{
+			std::shared_ptr<library::XML> xml(new library::XML());
+			xml->setTag(tag);
+			xml->setProperty("elapsed", getElapsedTime());
+
+			std::map<std::string, Gauge> gauges;
+			{
+				std::shared_lock<std::shared_mutex> uk(mtx);
+				gauges = this->gauges;
+
+				for (auto it = counters.begin(); it != counters.end(); it++)
+				{
+					std::shared_ptr<library::XML> counter(new library::XML());
+					counter->setTag("counter");
+					counter->setProperty("name", it->first);
+					counter->setProperty("value", it->second->load(std::memory_order_relaxed));
+
+					xml->push_back(counter);
+				}
+				for (auto it = histograms.begin(); it != histograms.end(); it++)
+				{
+					std::shared_ptr<library::XML> histogram = it->second->toXML();
+					histogram->setProperty("name", it->first);
+
+					xml->push_back(histogram);
+				}
+			}
+
+			// GAUGES MAY LOCK, THUS OUT OF THE LOCK
+			for (auto it = gauges.begin(); it != gauges.end(); it++)
+			{
+				std::shared_ptr<library::XML> gauge(new library::XML());
+				gauge->setTag("gauge");
+				gauge->setProperty("name", it->first);
+				gauge->setProperty("value", it->second());
+
+				xml->push_back(gauge);
+			}
+			return xml;
+		};
+	};
+};
+};
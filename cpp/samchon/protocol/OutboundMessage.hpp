@@ -0,0 +1,213 @@
+#pragma once
+#include <samchon/API.hpp>
+
+#include <samchon/protocol/Invoke.hpp>
+
+#include <deque>
+#include <functional>
+#include <string>
+#include <vector>
+#include <boost/asio.hpp>
+#include <samchon/ByteArray.hpp>
+
+namespace samchon
+{
+namespace protocol
+{
+	/**
+	 * An outbound message, frames of an {@link Invoke} to be written at once.
+	 *
+	 * The {@link OutboundMessage} collects all the frames of an {@link Invoke} message, which are the frame of the
+	 * {@link Invoke} itself and frames of its *ByteArray* parameters, with their headers. Then a {@link Communicator}
+	 * writes them by a single vectored (scatter-gather) write, until every byte has been sent.
+	 *
+	 * Pieces built for the message (headers, an encoded {@link Invoke}) are owned by the {@link OutboundMessage}. Contents
+	 * of *ByteArray* parameters are not copied, but referred; the {@link OutboundMessage} keeps the {@link Invoke} alive
+	 * until it has been written. Thus, don't modify the *ByteArray* parameters after sending.
+	 *
+	 * An {@link OutboundMessage} can also be a batch of other messages, by {@link append append()}. Small pieces of the
+	 * appended messages are coalesced into contiguous blocks, so that a writer can send many queued messages by a few
+	 * large writes.
+	 *
+	 * @see {@link Communicator}
+	 * @author Jeongho Nam <http://samchon.org>
+	 */
+	class OutboundMessage
+	{
+	private:
+		std::shared_ptr<Invoke> invoke;
+
+		std::deque<ByteArray> byte_arrays;
+		std::deque<std::string> strings;
+
+		std::vector<boost::asio::const_buffer> buffers;
+		size_t size_;
+
+		// BATCH
+		std::vector<std::shared_ptr<OutboundMessage>> children;
+		std::deque<ByteArray> blocks;
+
+		std::function<void(const boost::system::error_code&)> callback;
+
+	public:
+		/**
+		 * Pieces smaller than it are copied into a contiguous block when {@link append appended}.
+		 */
+		static const size_t COALESCE_LIMIT = 1024;
+
+		/**
+		 * Capacity of a block for coalescing.
+		 */
+		static const size_t COALESCE_BLOCK_SIZE = 64 * 1024;
+
+	public:
+		/* ---------------------------------------------------------
+			CONSTRUCTORS
+		--------------------------------------------------------- */
+		/**
+		 * Construct from an {@link Invoke} message.
+		 *
+		 * @param invoke An {@link Invoke} message to be kept alive until written.
+		 */
+		OutboundMessage(std::shared_ptr<Invoke> invoke = nullptr)
+		{
+			this->invoke = invoke;
+			this->size_ = 0;
+		};
+
+		/**
+		 * Append an owned piece.
+		 */
+		void push(ByteArray &&data)
+		{
+			byte_arrays.push_back(std::move(data));
+			refer(byte_arrays.back().data(), byte_arrays.back().size());
+		};
+
+		/**
+		 * Append an owned piece.
+		 */
+		void push(std::string &&data)
+		{
+			strings.push_back(std::move(data));
+			refer(strings.back().data(), strings.back().size());
+		};
+
+		/**
+		 * Append a referred piece.
+		 *
+		 * @param data Address of the piece, which must be alive until the message has been written.
+		 * @param size Size of the piece.
+		 */
+		void refer(const void *data, size_t size)
+		{
+			if (size == 0)
+				return;
+
+			buffers.emplace_back(data, size);
+			size_ += size;
+		};
+
+		/**
+		 * Append another message, as a batch.
+		 *
+		 * @param message An {@link OutboundMessage} to be written after pieces of this message.
+		 */
+		void append(std::shared_ptr<OutboundMessage> message)
+		{
+			children.push_back(message);
+
+			for (auto it = message->buffers.begin(); it != message->buffers.end(); it++)
+				if (it->size() < COALESCE_LIMIT)
+					coalesce(it->data(), it->size());
+				else
+					refer(it->data(), it->size());
+		};
+
+		/**
+		 * Set callback function for completion.
+		 *
+		 * @param callback A function called with result of the writing.
+		 */
+		void setCallback(std::function<void(const boost::system::error_code&)> callback)
+		{
+			this->callback = callback;
+		};
+
+		/**
+		 * Notify completion of the writing.
+		 *
+		 * Calls the {@link setCallback callback} of this message and all the {@link append appended} messages.
+		 *
+		 * @param error Result of the writing.
+		 */
+		void complete(const boost::system::error_code &error)
+		{
+			for (auto it = children.begin(); it != children.end(); it++)
+				(*it)->complete(error);
+
+			if (callback != nullptr)
+				callback(error);
+		};
+
+	private:
+		void coalesce(const void *data, size_t size)
+		{
+			const unsigned char *first = (const unsigned char*)data;
+
+			// EXTEND THE LAST BLOCK, WHICH NEVER REALLOCATES WITHIN ITS CAPACITY
+			if (blocks.empty() == false && buffers.empty() == false)
+			{
+				ByteArray &block = blocks.back();
+				const boost::asio::const_buffer &last = buffers.back();
+
+				if (block.capacity() - block.size() >= size 
+					&& (const unsigned char*)last.data() + last.size() == block.data() + block.size())
+				{
+					block.insert(block.end(), first, first + size);
+					buffers.back() = boost::asio::const_buffer(last.data(), last.size() + size);
+					size_ += size;
+
+					return;
+				}
+			}
+
+			// OR START A NEW BLOCK
+			blocks.emplace_back();
+			blocks.back().reserve(COALESCE_BLOCK_SIZE);
+			blocks.back().insert(blocks.back().end(), first, first + size);
+
+			refer(blocks.back().data(), size);
+		};
+
+	public:
+		/* ---------------------------------------------------------
+			ACCESSORS
+		--------------------------------------------------------- */
+		/**
+		 * Get the {@link Invoke} message, ```nullptr``` if this is a control frame or a batch.
+		 */
+		auto getInvoke() const -> std::shared_ptr<Invoke>
+		{
+			return invoke;
+		};
+
+		/**
+		 * Get buffer sequence to write.
+		 */
+		auto getBuffers() const -> const std::vector<boost::asio::const_buffer>&
+		{
+			return buffers;
+		};
+
+		/**
+		 * Get number of bytes to write.
+		 */
+		auto size() const -> size_t
+		{
+			return size_;
+		};
+
+	};
+};
+};
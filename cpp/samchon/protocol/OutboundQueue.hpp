@@ -0,0 +1,130 @@
+#pragma once
+#include <samchon/API.hpp>
+
+#include <samchon/protocol/OutboundMessage.hpp>
+
+#include <atomic>
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+namespace samchon
+{
+namespace protocol
+{
+	/**
+	 * A lock-free queue of outbound messages.
+	 *
+	 * The {@link OutboundQueue} is a multi-producer, single-consumer queue of {@link OutboundMessage messages} to write.
+	 * Any thread can {@link push} a message without locking. The consumer, a *writer*, is elected among the producers:
+	 * a producer pushing to an idle queue becomes the writer, and it keeps {@link pop popping} and writing until the
+	 * queue gets idle again. Thus only one thread writes to a socket at a time, and the other producers return
+	 * immediately.
+	 *
+	 * The writer {@link pop pops} all the queued messages at once, which makes coalescing them into large writes
+	 * possible.
+	 *
+	 * @see {@link Communicator}, {@link OutboundMessage}
+	 * @author Jeongho Nam <http://samchon.org>
+	 */
+	class OutboundQueue
+	{
+	private:
+		struct Node
+		{
+			std::shared_ptr<OutboundMessage> message;
+			Node *next;
+		};
+
+		std::atomic<Node*> head;
+		std::atomic<size_t> pending;
+
+	public:
+		/* ---------------------------------------------------------
+			CONSTRUCTORS
+		--------------------------------------------------------- */
+		/**
+		 * Default Constructor.
+		 */
+		OutboundQueue()
+			: head(nullptr), pending(0)
+		{
+		};
+		OutboundQueue(const OutboundQueue &) = delete;
+
+		/**
+		 * Default Destructor.
+		 */
+		~OutboundQueue()
+		{
+			Node *node = head.exchange(nullptr);
+			while (node != nullptr)
+			{
+				Node *next = node->next;
+				delete node;
+				node = next;
+			}
+		};
+
+		/* ---------------------------------------------------------
+			PRODUCER
+		--------------------------------------------------------- */
+		/**
+		 * Push a message.
+		 *
+		 * @param message An {@link OutboundMessage} to write.
+		 * @return Whether the caller has been elected as the writer.
+		 */
+		auto push(std::shared_ptr<OutboundMessage> message) -> bool
+		{
+			bool writer = (pending.fetch_add(1, std::memory_order_acq_rel) == 0);
+
+			Node *node = new Node{ message, head.load(std::memory_order_relaxed) };
+			while (head.compare_exchange_weak(node->next, node, std::memory_order_release, std::memory_order_relaxed) == false)
+				continue;
+
+			return writer;
+		};
+
+		/* ---------------------------------------------------------
+			CONSUMER, THE WRITER ONLY
+		--------------------------------------------------------- */
+		/**
+		 * Pop all the queued messages.
+		 *
+		 * A message being pushed concurrently may not have arrived yet. Then the returned batch is empty, although
+		 * {@link complete complete()} tells to continue.
+		 *
+		 * @param messages Container to be filled with popped messages, in order of pushing.
+		 */
+		void pop(std::vector<std::shared_ptr<OutboundMessage>> &messages)
+		{
+			size_t first = messages.size();
+
+			Node *node = head.exchange(nullptr, std::memory_order_acquire);
+			while (node != nullptr)
+			{
+				messages.push_back(std::move(node->message));
+
+				Node *next = node->next;
+				delete node;
+				node = next;
+			}
+
+			// STACK TO QUEUE
+			std::reverse(messages.begin() + first, messages.end());
+		};
+
+		/**
+		 * Report popped messages have been written.
+		 *
+		 * @param count Number of written messages.
+		 * @return Whether the writer must continue, because messages have been pushed during the writing.
+		 */
+		auto complete(size_t count) -> bool
+		{
+			return pending.fetch_sub(count, std::memory_order_acq_rel) != count;
+		};
+	};
+};
+};
@@ -0,0 +1,233 @@
+#pragma once
+#include <samchon/API.hpp>
+
+#include <samchon/protocol/Invoke.hpp>
+#include <samchon/protocol/IOServicePool.hpp>
+
+#include <chrono>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include <boost/asio.hpp>
+#include <boost/asio/steady_timer.hpp>
+
+namespace samchon
+{
+namespace protocol
+{
+	/**
+	 * Requests waiting for their replies.
+	 *
+	 * The {@link PendingCalls} correlates {@link Invoke} messages sent by {@link Communicator.call Communicator.call()}
+	 * with their replies. Each request is given a unique ID, carried by the {@link CALL_UID} parameter of the request
+	 * and the {@link REPLY_UID} parameter of its reply. Any number of requests can be outstanding at a time, and their
+	 * replies may arrive in any order.
+	 *
+	 * A request is completed exactly once; by its reply, by its timeout, or by disconnection. Handlers are called
+	 * outside of the lock, from the thread completing the request.
+	 *
+	 * @see {@link Communicator}
+	 * @author Jeongho Nam <http://samchon.org>
+	 */
+	class PendingCalls
+		: public std::enable_shared_from_this<PendingCalls>
+	{
+	public:
+		/**
+		 * A function called with the reply, or with an error.
+		 */
+		typedef std::function<void(std::shared_ptr<Invoke>, std::exception_ptr)> Handler;
+
+	private:
+		struct Call
+		{
+			Handler handler;
+			std::unique_ptr<boost::asio::steady_timer> timer;
+		};
+
+		std::mutex mtx;
+		std::unordered_map<size_t, Call> calls;
+		size_t sequence;
+
+	public:
+		/* ---------------------------------------------------------
+			CONSTRUCTORS
+		--------------------------------------------------------- */
+		/**
+		 * Default Constructor.
+		 */
+		PendingCalls()
+		{
+			sequence = 0;
+		};
+		PendingCalls(const PendingCalls &) = delete;
+
+		/**
+		 * Name of the parameter carrying a request's ID.
+		 */
+		static auto CALL_UID() -> const std::string&
+		{
+			static const std::string name = "_Call_uid";
+			return name;
+		};
+
+		/**
+		 * Name of the parameter carrying ID of the request which a reply is for.
+		 */
+		static auto REPLY_UID() -> const std::string&
+		{
+			static const std::string name = "_Reply_uid";
+			return name;
+		};
+
+		/* ---------------------------------------------------------
+			REQUESTS
+		--------------------------------------------------------- */
+		/**
+		 * Register a request.
+		 *
+		 * @param handler A function to be called with the reply.
+		 * @return ID of the request.
+		 */
+		auto push(Handler handler) -> size_t
+		{
+			std::unique_lock<std::mutex> uk(mtx);
+
+			size_t uid = ++sequence;
+			calls[uid].handler = handler;
+
+			return uid;
+		};
+
+		/**
+		 * Register a request with timeout.
+		 *
+		 * @param handler A function to be called with the reply.
+		 * @param timeout Time to wait for the reply. The request fails by ```boost::asio::error::timed_out``` after it.
+		 * @param service An I/O service to run the timer.
+		 * @return ID of the request.
+		 */
+		auto push(Handler handler, std::chrono::steady_clock::duration timeout, boost::asio::io_service &service) -> size_t
+		{
+			std::weak_ptr<PendingCalls> weak = shared_from_this();
+			std::unique_ptr<boost::asio::steady_timer> timer(new boost::asio::steady_timer(service, timeout));
+
+			std::unique_lock<std::mutex> uk(mtx);
+			size_t uid = ++sequence;
+
+			timer->async_wait([weak, uid](const boost::system::error_code &error)
+			{
+				std::shared_ptr<PendingCalls> calls = weak.lock();
+				if (error || calls == nullptr)
+					return; // CANCELED
+
+				calls->reject(uid, std::make_exception_ptr(boost::system::system_error(boost::asio::error::timed_out)));
+			});
+
+			Call &call = calls[uid];
+			call.handler = handler;
+			call.timer = std::move(timer);
+
+			return uid;
+		};
+
+		/**
+		 * Complete a request by its reply.
+		 *
+		 * @param uid ID of the request.
+		 * @param reply The reply.
+		 * @return Whether the request was waiting, not completed yet.
+		 */
+		auto resolve(size_t uid, std::shared_ptr<Invoke> reply) -> bool
+		{
+			Handler handler;
+			if (pop(uid, handler) == false)
+				return false;
+
+			handler(reply, nullptr);
+			return true;
+		};
+
+		/**
+		 * Fail a request.
+		 *
+		 * @param uid ID of the request.
+		 * @param error Reason of the failure.
+		 * @return Whether the request was waiting, not completed yet.
+		 */
+		auto reject(size_t uid, std::exception_ptr error) -> bool
+		{
+			Handler handler;
+			if (pop(uid, handler) == false)
+				return false;
+
+			handler(nullptr, error);
+			return true;
+		};
+
+		/**
+		 * Fail all the requests, like on disconnection.
+		 *
+		 * @param error Reason of the failure.
+		 */
+		void rejectAll(std::exception_ptr error)
+		{
+			std::vector<Handler> handlers;
+			{
+				std::unique_lock<std::mutex> uk(mtx);
+
+				handlers.reserve(calls.size());
+				for (auto it = calls.begin(); it != calls.end(); it++)
+				{
+					if (it->second.timer != nullptr)
+						it->second.timer->cancel();
+					handlers.push_back(std::move(it->second.handler));
+				}
+				calls.clear();
+			}
+
+			for (size_t i = 0; i < handlers.size(); i++)
+				handlers[i](nullptr, error);
+		};
+
+		/**
+		 * Get number of requests waiting for their replies.
+		 */
+		auto size() -> size_t
+		{
+			std::unique_lock<std::mutex> uk(mtx);
+			return calls.size();
+		};
+
+		/**
+		 * I/O service running timers of connections in the blocking mode, which have no I/O service of their own.
+		 */
+		static auto getTimerService() -> boost::asio::io_service&
+		{
+			// NEVER DESTRUCTED, FOR TIMERS CANCELED AT EXIT
+			static IOServicePool *pool = new IOServicePool(1);
+			return pool->getService();
+		};
+
+	private:
+		auto pop(size_t uid, Handler &handler) -> bool
+		{
+			std::unique_lock<std::mutex> uk(mtx);
+
+			auto it = calls.find(uid);
+			if (it == calls.end())
+				return false;
+
+			if (it->second.timer != nullptr)
+				it->second.timer->cancel();
+			handler = std::move(it->second.handler);
+
+			calls.erase(it);
+			return true;
+		};
+	};
+};
+};
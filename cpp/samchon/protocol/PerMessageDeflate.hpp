@@ -0,0 +1,356 @@
+#pragma once
+#include <samchon/API.hpp>
+
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <zlib.h>
+#include <samchon/ByteArray.hpp>
+#include <samchon/WeakString.hpp>
+
+namespace samchon
+{
+namespace protocol
+{
+	/**
+	 * Per-message compression of Web-socket, *permessage-deflate*.
+	 *
+	 * The {@link PerMessageDeflate} is an extension of Web-socket protocol, defined in RFC 7692, which compresses each
+	 * message by the DEFLATE algorithm. It is negotiated on handshake by the ```Sec-WebSocket-Extensions``` header,
+	 * and a compressed message is marked by the RSV1 bit of its frame. Browsers support it.
+	 *
+	 * With *context takeover*, a message is compressed with the sliding window of the previous messages, which makes
+	 * similar messages (like entity snapshots) much smaller. Without it, a context is reset for each message, which
+	 * saves memory of the connection. It can be configured for each direction.
+	 *
+	 * A {@link PerMessageDeflate} object holds both compression and decompression contexts of a connection. Calls of
+	 * {@link compress compress()} must be serialized in order of the messages on wire, and so must those of
+	 * {@link decompress decompress()}.
+	 *
+	 * @see {@link WebCommunicator}, {@link WebServer}, {@link WebServerConnector}
+	 * @author Jeongho Nam <http://samchon.org>
+	 */
+	class PerMessageDeflate
+	{
+	public:
+		/**
+		 * Messages smaller than it are not compressed.
+		 */
+		static const size_t THRESHOLD = 128;
+
+	private:
+		z_stream deflater;
+		z_stream inflater;
+
+		bool deflate_context_takeover;
+		bool inflate_context_takeover;
+
+	public:
+		/* ---------------------------------------------------------
+			CONSTRUCTORS
+		--------------------------------------------------------- */
+		/**
+		 * Construct from negotiated parameters.
+		 *
+		 * @param deflate_context_takeover Whether to keep the compression context across messages.
+		 * @param inflate_context_takeover Whether to keep the decompression context across messages.
+		 * @param deflate_window_bits Size of the compression window, from 9 to 15.
+		 */
+		PerMessageDeflate(bool deflate_context_takeover, bool inflate_context_takeover, int deflate_window_bits = 15)
+		{
+			this->deflate_context_takeover = deflate_context_takeover;
+			this->inflate_context_takeover = inflate_context_takeover;
+
+			deflater = {};
+			inflater = {};
+
+			// RAW DEFLATE, WITHOUT ZLIB HEADER
+			if (deflateInit2(&deflater, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -deflate_window_bits, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+				throw std::invalid_argument("invalid window bits of permessage-deflate.");
+			if (inflateInit2(&inflater, -15) != Z_OK)
+			{
+				deflateEnd(&deflater);
+				throw std::runtime_error("failed to initialize zlib.");
+			}
+		};
+		PerMessageDeflate(const PerMessageDeflate &) = delete;
+
+		~PerMessageDeflate()
+		{
+			deflateEnd(&deflater);
+			inflateEnd(&inflater);
+		};
+
+		/* ---------------------------------------------------------
+			NEGOTIATION
+		--------------------------------------------------------- */
+		/**
+		 * Name of the extension.
+		 */
+		static auto NAME() -> std::string
+		{
+			return "permessage-deflate";
+		};
+
+		/**
+		 * Make an offer, by a client.
+		 *
+		 * @param context_takeover Whether to allow context takeover in both directions.
+		 * @return Value of the ```Sec-WebSocket-Extensions``` header.
+		 */
+		static auto offer(bool context_takeover) -> std::string
+		{
+			std::string extension = NAME() + "; client_max_window_bits";
+			if (context_takeover == false)
+				extension += "; server_no_context_takeover; client_no_context_takeover";
+
+			return extension;
+		};
+
+		/**
+		 * Accept an offer, by a server.
+		 *
+		 * @param extensions Value of the client's ```Sec-WebSocket-Extensions``` header.
+		 * @param context_takeover Whether to allow context takeover in both directions.
+		 * @param response Value of the ```Sec-WebSocket-Extensions``` header to reply, if accepted.
+		 *
+		 * @return A {@link PerMessageDeflate} of the server side, ```nullptr``` if no offer is acceptable.
+		 */
+		static auto accept(const std::string &extensions, bool context_takeover, std::string &response) -> std::shared_ptr<PerMessageDeflate>
+		{
+			std::vector<WeakString> offers = WeakString(extensions).split(",");
+
+			for (size_t i = 0; i < offers.size(); i++)
+			{
+				std::vector<WeakString> params = offers[i].split(";");
+				if (params.front().trim() != NAME())
+					continue;
+
+				bool server_takeover = context_takeover;
+				bool client_takeover = context_takeover;
+				int server_window_bits = 15;
+				bool acceptable = true;
+
+				for (size_t j = 1; j < params.size() && acceptable == true; j++)
+				{
+					WeakString name = params[j].between("", "=").trim();
+					WeakString value = params[j].find("=") == WeakString::npos
+						? WeakString()
+						: params[j].between("=").trim();
+
+					if (name == "server_no_context_takeover")
+						server_takeover = false;
+					else if (name == "client_no_context_takeover")
+						client_takeover = false;
+					else if (name == "server_max_window_bits")
+					{
+						// RAW DEFLATE OF ZLIB CAN'T USE A WINDOW OF 8 BITS
+						server_window_bits = value.empty() ? 0 : std::atoi(value.str().c_str());
+						acceptable = (server_window_bits >= 9 && server_window_bits <= 15);
+					}
+					else if (name != "client_max_window_bits")
+						acceptable = false;
+				}
+				if (acceptable == false)
+					continue;
+
+				// RESPONSE
+				response = NAME();
+				if (server_takeover == false)
+					response += "; server_no_context_takeover";
+				if (client_takeover == false)
+					response += "; client_no_context_takeover";
+				if (server_window_bits != 15)
+					response += "; server_max_window_bits=" + std::to_string(server_window_bits);
+
+				return std::make_shared<PerMessageDeflate>(server_takeover, client_takeover, server_window_bits);
+			}
+			return nullptr;
+		};
+
+		/**
+		 * Construct from a server's response, by a client.
+		 *
+		 * @param extensions Value of the server's ```Sec-WebSocket-Extensions``` header.
+		 * @param context_takeover Whether the client has allowed context takeover, in its {@link offer}.
+		 * @return A {@link PerMessageDeflate} of the client side, ```nullptr``` if the server has declined.
+		 * @throw domain_error If the response is not acceptable.
+		 */
+		static auto construct(const std::string &extensions, bool context_takeover) -> std::shared_ptr<PerMessageDeflate>
+		{
+			std::vector<WeakString> params = WeakString(extensions).split(";");
+			if (params.front().trim() != NAME())
+				return nullptr;
+
+			bool server_takeover = context_takeover;
+			bool client_takeover = context_takeover;
+			int client_window_bits = 15;
+
+			for (size_t i = 1; i < params.size(); i++)
+			{
+				WeakString name = params[i].between("", "=").trim();
+				WeakString value = params[i].find("=") == WeakString::npos
+					? WeakString()
+					: params[i].between("=").trim();
+
+				if (name == "server_no_context_takeover")
+					server_takeover = false;
+				else if (name == "client_no_context_takeover")
+					client_takeover = false;
+				else if (name == "client_max_window_bits")
+				{
+					client_window_bits = value.empty() ? 0 : std::atoi(value.str().c_str());
+					if (client_window_bits < 9 || client_window_bits > 15)
+						throw std::domain_error("unsupported client_max_window_bits of permessage-deflate.");
+				}
+				else if (name != "server_max_window_bits")
+					throw std::domain_error("unknown parameter of permessage-deflate.");
+			}
+			return std::make_shared<PerMessageDeflate>(client_takeover, server_takeover, client_window_bits);
+		};
+
+		/* ---------------------------------------------------------
+			COMPRESSION
+		--------------------------------------------------------- */
+		/**
+		 * Compress a message.
+		 *
+		 * @param data Content of the message.
+		 * @param size Size of the content.
+		 * @return Payload of the compressed message.
+		 */
+		auto compress(const unsigned char *data, size_t size) -> ByteArray
+		{
+			ByteArray ret;
+			ret.resizeUninitialized(std::max<size_t>(size / 2, 64));
+
+			size_t written = 0;
+			while (true)
+			{
+				// FEED INPUT BY CHUNKS OF UINT
+				if (deflater.avail_in == 0 && size != 0)
+				{
+					size_t piece = std::min<size_t>(size, UINT_MAX);
+
+					deflater.next_in = (Bytef*)data;
+					deflater.avail_in = (uInt)piece;
+					data += piece;
+					size -= piece;
+				}
+
+				// EXTEND OUTPUT
+				if (written == ret.size())
+					ret.resizeUninitialized(ret.size() * 2);
+
+				deflater.next_out = ret.data() + written;
+				deflater.avail_out = (uInt)std::min<size_t>(ret.size() - written, UINT_MAX);
+
+				uInt capacity = deflater.avail_out;
+				int result = deflate(&deflater, (size == 0) ? Z_SYNC_FLUSH : Z_NO_FLUSH);
+				written += capacity - deflater.avail_out;
+
+				if (result != Z_OK && result != Z_BUF_ERROR)
+					throw std::runtime_error("failed to compress a message.");
+
+				// FLUSHED COMPLETELY
+				if (size == 0 && deflater.avail_in == 0 && deflater.avail_out != 0)
+					break;
+			}
+
+			// REMOVE THE TAIL OF SYNC FLUSH, 00 00 FF FF
+			ret.resize(written - 4);
+
+			if (deflate_context_takeover == false)
+				deflateReset(&deflater);
+			return ret;
+		};
+
+		/**
+		 * Decompress a message.
+		 *
+		 * @param data Payload of the compressed message.
+		 * @param size Size of the payload.
+		 * @param max_size Maximum size of the message.
+		 * @return Content of the message.
+		 * @throw domain_error If the payload is not valid.
+		 * @throw length_error If the message exceeds the *max_size*. The context is broken then.
+		 */
+		auto decompress(const unsigned char *data, size_t size, size_t max_size = SIZE_MAX) -> ByteArray
+		{
+			static const unsigned char TAIL[4] = { 0x00, 0x00, 0xFF, 0xFF };
+
+			// A BYTE OVER THE MAX_SIZE TELLS IT'S BEEN EXCEEDED
+			size_t limit = (max_size == SIZE_MAX) ? SIZE_MAX : max_size + 1;
+
+			ByteArray ret;
+			ret.resizeUninitialized(std::min<size_t>(std::max<size_t>(size * 4, 64), limit));
+
+			size_t written = 0;
+			bool tail = false;
+
+			while (true)
+			{
+				// FEED INPUT BY CHUNKS OF UINT, THEN THE TAIL OF SYNC FLUSH
+				if (inflater.avail_in == 0)
+				{
+					if (size != 0)
+					{
+						size_t piece = std::min<size_t>(size, UINT_MAX);
+
+						inflater.next_in = (Bytef*)data;
+						inflater.avail_in = (uInt)piece;
+						data += piece;
+						size -= piece;
+					}
+					else if (tail == false)
+					{
+						inflater.next_in = (Bytef*)TAIL;
+						inflater.avail_in = 4;
+						tail = true;
+					}
+				}
+
+				// EXTEND OUTPUT, UNTIL THE LIMIT
+				if (written == ret.size())
+					ret.resizeUninitialized((ret.size() > limit / 2) ? limit : ret.size() * 2);
+
+				inflater.next_out = ret.data() + written;
+				inflater.avail_out = (uInt)std::min<size_t>(ret.size() - written, UINT_MAX);
+
+				uInt capacity = inflater.avail_out;
+				int result = inflate(&inflater, Z_SYNC_FLUSH);
+				written += capacity - inflater.avail_out;
+
+				if (written > max_size)
+				{
+					inflater.avail_in = 0;
+					throw std::length_error("decompressed message exceeds the maximum size.");
+				}
+
+				if (result == Z_STREAM_END)
+				{
+					// A FINAL BLOCK ENDS THE CONTEXT
+					inflateReset(&inflater);
+					break;
+				}
+				else if (result != Z_OK && result != Z_BUF_ERROR)
+					throw std::domain_error("invalid payload of permessage-deflate.");
+
+				// ALL CONSUMED AND FLUSHED
+				if (tail == true && inflater.avail_in == 0 && inflater.avail_out != 0)
+					break;
+			}
+			ret.resize(written);
+			inflater.avail_in = 0;
+
+			if (inflate_context_takeover == false)
+				inflateReset(&inflater);
+			return ret;
+		};
+	};
+};
+};
@@ -0,0 +1,134 @@
+#pragma once
+#include <samchon/API.hpp>
+
+#include <cstring>
+#include <memory>
+#include <boost/asio.hpp>
+
+namespace samchon
+{
+namespace protocol
+{
+	/**
+	 * A receive buffer.
+	 *
+	 * The {@link ReceiveBuffer} is a fixed-capacity byte buffer between a socket and a frame parser. A
+	 * {@link Communicator} reads bytes from its socket into the {@link prepare prepared} space by large chunks, then
+	 * parses as many complete frames as are buffered, without a system call per frame.
+	 *
+	 * Consumed bytes are reclaimed by moving the unconsumed remainder, a partial frame which is small, to the front of the
+	 * buffer when more space is {@link prepare prepared}. Thus buffered bytes are always contiguous and a frame header can
+	 * be parsed in place.
+	 *
+	 * @see {@link Communicator}
+	 * @author Jeongho Nam <http://samchon.org>
+	 */
+	class ReceiveBuffer
+	{
+	private:
+		std::unique_ptr<unsigned char[]> data_;
+		size_t capacity_;
+
+		size_t first;
+		size_t last;
+
+	public:
+		/* ---------------------------------------------------------
+			CONSTRUCTORS
+		--------------------------------------------------------- */
+		/**
+		 * Construct from capacity.
+		 *
+		 * @param capacity Capacity of the buffer, the maximum size of a read.
+		 */
+		ReceiveBuffer(size_t capacity = 64 * 1024)
+			: data_(new unsigned char[capacity])
+		{
+			capacity_ = capacity;
+
+			first = 0;
+			last = 0;
+		};
+		ReceiveBuffer(const ReceiveBuffer &) = delete;
+
+		/* ---------------------------------------------------------
+			READER
+		--------------------------------------------------------- */
+		/**
+		 * Get address of the buffered bytes.
+		 */
+		auto data() const -> const unsigned char*
+		{
+			return data_.get() + first;
+		};
+
+		/**
+		 * Get address of the buffered bytes, to be modified in place, like unmasking.
+		 */
+		auto data() -> unsigned char*
+		{
+			return data_.get() + first;
+		};
+
+		/**
+		 * Get number of the buffered bytes.
+		 */
+		auto size() const -> size_t
+		{
+			return last - first;
+		};
+
+		/**
+		 * Get capacity.
+		 */
+		auto capacity() const -> size_t
+		{
+			return capacity_;
+		};
+
+		/**
+		 * Consume buffered bytes.
+		 *
+		 * @param size Number of bytes to consume.
+		 */
+		void consume(size_t size)
+		{
+			first += size;
+
+			if (first == last)
+				first = last = 0;
+		};
+
+		/* ---------------------------------------------------------
+			WRITER
+		--------------------------------------------------------- */
+		/**
+		 * Prepare space to read into.
+		 *
+		 * @return A buffer for the socket to read into, followed by {@link commit commit()}.
+		 */
+		auto prepare() -> boost::asio::mutable_buffer
+		{
+			if (first != 0)
+			{
+				// MOVE THE PARTIAL FRAME TO THE FRONT
+				std::memmove(data_.get(), data_.get() + first, last - first);
+
+				last -= first;
+				first = 0;
+			}
+			return boost::asio::mutable_buffer(data_.get() + last, capacity_ - last);
+		};
+
+		/**
+		 * Commit bytes read into the {@link prepare prepared} space.
+		 *
+		 * @param size Number of bytes read.
+		 */
+		void commit(size_t size)
+		{
+			last += size;
+		};
+	};
+};
+};
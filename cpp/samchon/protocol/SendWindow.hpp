@@ -0,0 +1,246 @@
+#pragma once
+#include <samchon/API.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <stdexcept>
+
+namespace samchon
+{
+namespace protocol
+{
+	/**
+	 * A window bounding bytes queued to be written.
+	 *
+	 * The {@link SendWindow} counts bytes of messages which have been sent but not written yet. When the count reaches
+	 * the {@link getHighWatermark high watermark}, the remote system is regarded as a slow consumer, and the
+	 * {@link Policy policy} is applied until the count falls to the {@link getLowWatermark low watermark}.
+	 *
+	 * Policy					| Over the high watermark
+	 * -------------------------|----------------------------------------------------------------------
+	 * {@link BLOCK}			| Senders are blocked until the low watermark.
+	 * {@link DROP_OLDEST}		| The oldest messages not written yet are dropped, to the low watermark.
+	 * {@link COALESCE}			| Of messages not written yet, only the latest one of each listener is kept.
+	 * {@link DISCONNECT}		| The connection is closed.
+	 *
+	 * The window is unbounded by default.
+	 *
+	 * @see {@link Communicator}
+	 * @author Jeongho Nam <http://samchon.org>
+	 */
+	class SendWindow
+	{
+	public:
+		/**
+		 * Policies for a slow consumer.
+		 */
+		enum Policy : unsigned char
+		{
+			/**
+			 * Block senders.
+			 */
+			BLOCK = 1,
+
+			/**
+			 * Drop the oldest messages.
+			 */
+			DROP_OLDEST = 2,
+
+			/**
+			 * Keep only the latest message of each listener.
+			 */
+			COALESCE = 3,
+
+			/**
+			 * Close the connection.
+			 */
+			DISCONNECT = 4
+		};
+
+	private:
+		std::mutex mtx;
+		std::condition_variable cv;
+
+		size_t high_watermark;
+		size_t low_watermark;
+		Policy policy;
+
+		size_t bytes;
+		std::atomic<bool> over;
+		bool closed;
+
+	public:
+		/* ---------------------------------------------------------
+			CONSTRUCTORS
+		--------------------------------------------------------- */
+		/**
+		 * Default Constructor, an unbounded window.
+		 */
+		SendWindow()
+		{
+			high_watermark = 0;
+			low_watermark = 0;
+			policy = BLOCK;
+
+			bytes = 0;
+			over = false;
+			closed = false;
+		};
+		SendWindow(const SendWindow &) = delete;
+
+		/**
+		 * Configure the window.
+		 *
+		 * @param high_watermark Bytes making the remote system a slow consumer. Zero means unbounded.
+		 * @param low_watermark Bytes making the remote system healthy again.
+		 * @param policy A {@link Policy} for the slow consumer.
+		 *
+		 * @throw std::invalid_argument The *low_watermark* is larger than the *high_watermark*.
+		 */
+		void configure(size_t high_watermark, size_t low_watermark, Policy policy)
+		{
+			if (high_watermark != 0 && low_watermark > high_watermark)
+				throw std::invalid_argument("low watermark is larger than the high watermark.");
+
+			std::unique_lock<std::mutex> uk(mtx);
+
+			this->high_watermark = high_watermark;
+			this->low_watermark = low_watermark;
+			this->policy = policy;
+
+			cv.notify_all();
+		};
+
+		/* ---------------------------------------------------------
+			ACCESSORS
+		--------------------------------------------------------- */
+		auto getHighWatermark() -> size_t
+		{
+			std::unique_lock<std::mutex> uk(mtx);
+			return high_watermark;
+		};
+
+		auto getLowWatermark() -> size_t
+		{
+			std::unique_lock<std::mutex> uk(mtx);
+			return low_watermark;
+		};
+
+		auto getPolicy() -> Policy
+		{
+			std::unique_lock<std::mutex> uk(mtx);
+			return policy;
+		};
+
+		/**
+		 * Get number of bytes queued.
+		 */
+		auto size() -> size_t
+		{
+			std::unique_lock<std::mutex> uk(mtx);
+			return bytes;
+		};
+
+		/**
+		 * Test whether the remote system is a slow consumer, over the high watermark.
+		 */
+		auto isOver() const -> bool
+		{
+			return over;
+		};
+
+		/**
+		 * Test whether queued messages have to be shed, by {@link DROP_OLDEST} or {@link COALESCE}.
+		 */
+		auto isShedding() -> bool
+		{
+			if (over == false)
+				return false;
+
+			std::unique_lock<std::mutex> uk(mtx);
+			return policy == DROP_OLDEST || policy == COALESCE;
+		};
+
+		/* ---------------------------------------------------------
+			COUNTING
+		--------------------------------------------------------- */
+		/**
+		 * Wait for the low watermark, by the {@link BLOCK} policy.
+		 *
+		 * Returns immediately by the other policies, or after the window has been {@link close closed}, until it has
+		 * been {@link open opened} again.
+		 */
+		void wait()
+		{
+			if (over == false)
+				return;
+
+			std::unique_lock<std::mutex> uk(mtx);
+			while (over == true && policy == BLOCK && closed == false)
+				cv.wait(uk);
+		};
+
+		/**
+		 * Count bytes of a message queued.
+		 *
+		 * @param size Bytes of the message.
+		 * @return Whether the window has just reached the high watermark.
+		 */
+		auto acquire(size_t size) -> bool
+		{
+			std::unique_lock<std::mutex> uk(mtx);
+			bytes += size;
+
+			if (over == true || high_watermark == 0 || bytes < high_watermark)
+				return false;
+
+			over = true;
+			return true;
+		};
+
+		/**
+		 * Discount bytes of a message written or dropped.
+		 *
+		 * @param size Bytes of the message.
+		 * @return Whether the window has just fallen to the low watermark.
+		 */
+		auto release(size_t size) -> bool
+		{
+			std::unique_lock<std::mutex> uk(mtx);
+			bytes -= std::min(bytes, size);
+
+			if (over == false || bytes > low_watermark)
+				return false;
+
+			over = false;
+			cv.notify_all();
+
+			return true;
+		};
+
+		/**
+		 * Block senders again, on a connection started listening after the window has been {@link close closed}, like
+		 * a reconnection.
+		 */
+		void open()
+		{
+			std::unique_lock<std::mutex> uk(mtx);
+
+			closed = false;
+		};
+
+		/**
+		 * Release blocked senders, on disconnection.
+		 */
+		void close()
+		{
+			std::unique_lock<std::mutex> uk(mtx);
+
+			closed = true;
+			cv.notify_all();
+		};
+	};
+};
+};
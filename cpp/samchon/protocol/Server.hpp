@@ -2,8 +2,14 @@
 #include <samchon/API.hpp>
 
 #include <samchon/protocol/ClientDriver.hpp>
+#include <samchon/protocol/LoopbackCommunicator.hpp>
 
+#include <algorithm>
+#include <mutex>
 #include <thread>
+#include <samchon/protocol/IOServicePool.hpp>
+#include <samchon/protocol/SharedMemorySocket.hpp>
+#include <samchon/protocol/SocketOptions.hpp>
 
 namespace samchon
 {
@@ -36,6 +42,24 @@ namespace protocol
 	 * Samchon Framework's own | {@link Server}    | {@link ClientDriver}
 	 * Web-socket protocol     | {@link WebServer} | {@link WebClientDriver}
 	 * 
+	 * By default, {@link open open()} blocks and each client is handled by its own thread. To serve many clients on a 
+	 * fixed number of threads, deliver an {@link IOServicePool} by {@link setIOServicePool setIOServicePool()} before 
+	 * opening the server.
+	 * 
+	 * Accepted sockets are tuned by {@link SocketOptions}, *TCP_NODELAY* by default. Deliver other options by 
+	 * {@link setSocketOptions setSocketOptions()} before opening the server.
+	 * 
+	 * A server expecting a storm of connections, like a master whose slaves reconnect after its restart, can open 
+	 * multiple acceptors by {@link setAcceptors setAcceptors()}. Each acceptor listens the same port on its own socket 
+	 * with *SO_REUSEPORT*, driven by its own thread, and the kernel distributes incoming connections among them.
+	 * 
+	 * Systems on the same host can skip the loopback TCP. Open a local server by {@link openLocal openLocal()}, then 
+	 * {@link ServerConnector ServerConnectors} connecting to ```unix:/path``` are served by a Unix domain socket, and 
+	 * those connecting to ```shm:/path``` by {@link SharedMemorySocket shared memory}.
+	 * 
+	 * For tests and benchmarks without any socket, an end of a {@link LoopbackCommunicator} pair can be delivered by 
+	 * {@link accept accept()}, as if a client had connected.
+	 * 
 	 * ![Basic Components](http://samchon.github.io/framework/images/design/cpp_class_diagram/protocol_basic_components.png)
 	 *
 	 * @see {@link ClientDriver}
@@ -47,12 +71,48 @@ namespace protocol
 	protected:
 		std::unique_ptr<boost::asio::ip::tcp::acceptor> _Acceptor;
 
+		/**
+		 * Reactor of the asynchronous mode, ```nullptr``` in the blocking mode.
+		 */
+		std::shared_ptr<IOServicePool> service_pool;
+
+		/**
+		 * Options applied to the listening socket and every accepted socket.
+		 */
+		SocketOptions socket_options;
+
+	private:
+		/**
+		 * An acceptor of the multiple acceptors, with its own reactor.
+		 */
+		struct AcceptorThread
+		{
+			boost::asio::io_service service;
+			boost::asio::ip::tcp::acceptor acceptor;
+			std::thread thread;
+
+			AcceptorThread()
+				: acceptor(service)
+			{
+			};
+		};
+
+		size_t acceptor_count;
+		std::mutex acceptors_mutex;
+		std::vector<std::shared_ptr<AcceptorThread>> acceptors;
+
+#ifdef SAMCHON_LOCAL_SOCKET
+		std::unique_ptr<boost::asio::local::stream_protocol::acceptor> local_acceptor;
+		std::string local_path;
+#endif
+
 	public:
 		/**
 		 * Default Constructor.
 		 */
 		Server()
 		{
+			acceptor_count = 1;
 		};
 
 		/**
@@ -60,12 +120,75 @@ namespace protocol
 		 */
 		virtual ~Server()
 		{
+			close_acceptors();
+
 			if (_Acceptor == nullptr || _Acceptor->is_open() == false)
 				return;
 
 			close();
 		};
 
+		/**
+		 * Set I/O service pool.
+		 * 
+		 * Switches the {@link Server} to the asynchronous mode. Connections are accepted, read and written by the 
+		 * *pool*'s threads. Then {@link open open()} returns immediately and the {@link ClientDriver.listen} does not
+		 * block. It must be called before {@link open opening} the server.
+		 * 
+		 * @param pool An {@link IOServicePool} to drive the server and its clients.
+		 */
+		void setIOServicePool(std::shared_ptr<IOServicePool> pool)
+		{
+			service_pool = pool;
+		};
+
+		/**
+		 * Set socket options.
+		 * 
+		 * The *options* are applied to every socket accepted. It must be called before {@link open opening} the server.
+		 * 
+		 * @param options {@link SocketOptions} to apply.
+		 */
+		void setSocketOptions(const SocketOptions &options)
+		{
+			socket_options = options;
+		};
+
+		/**
+		 * Get socket options.
+		 */
+		auto getSocketOptions() const -> const SocketOptions&
+		{
+			return socket_options;
+		};
+
+		/**
+		 * Set number of acceptors.
+		 * 
+		 * Opens *count* listening sockets on the same port with *SO_REUSEPORT*, each accepting on its own thread, so 
+		 * that a burst of connections is not queued behind a single ```accept()```. In the asynchronous mode, accepted 
+		 * connections are handed over to the {@link IOServicePool}, and the acceptors' threads do nothing but accepting. 
+		 * In the blocking mode, {@link open open()} runs the first acceptor itself and blocks as before.
+		 * 
+		 * Note that {@link addClient addClient()} is called from the acceptors' threads concurrently. On platforms 
+		 * without *SO_REUSEPORT*, like Windows, it's ignored and the single acceptor is opened. It must be called 
+		 * before {@link open opening} the server.
+		 * 
+		 * @param count Number of acceptors. Default is 1, the single acceptor.
+		 */
+		void setAcceptors(size_t count)
+		{
+			acceptor_count = std::max<size_t>(count, 1);
+		};
+
+		/**
+		 * Get number of acceptors.
+		 */
+		auto getAcceptors() const -> size_t
+		{
+			return acceptor_count;
+		};
+
 		/**
 		 * Open server.
 		 * 
@@ -76,11 +199,32 @@ namespace protocol
 			if (_Acceptor != nullptr && _Acceptor->is_open())
 				return;
 
-			boost::asio::io_service io_service;
 			boost::asio::ip::tcp::endpoint endpoint(boost::asio::ip::tcp::v4(), port);
+
+#ifdef SO_REUSEPORT
+			// MULTIPLE ACCEPTORS
+			if (acceptor_count > 1)
+			{
+				open_acceptors(endpoint);
+				return;
+			}
+#endif
+
+			// ASYNCHRONOUS MODE
+			if (service_pool != nullptr)
+			{
+				_Acceptor.reset(new boost::asio::ip::tcp::acceptor(service_pool->getService()));
+				listen(*_Acceptor, endpoint);
+				accept_async();
+
+				return;
+			}
+
+			boost::asio::io_service io_service;
 			boost::system::error_code error;
 
-			_Acceptor.reset(new boost::asio::ip::tcp::acceptor(io_service, endpoint));
+			_Acceptor.reset(new boost::asio::ip::tcp::acceptor(io_service));
+			listen(*_Acceptor, endpoint);
 
 			while (true)
 			{
@@ -90,15 +234,130 @@ namespace protocol
 				if (error)
 					break;
 
-				std::thread(&Server::handle_connection, this, socket).detach();
+				socket_options.apply(*socket);
+				std::thread(&Server::handle_connection, this, std::make_shared<StreamSocket<boost::asio::ip::tcp>>(socket)).detach();
 			}
 		};
 
+		/**
+		 * Open a local server.
+		 * 
+		 * Opens the server at a Unix domain socket of the *path*, for systems on the same host. A 
+		 * {@link ServerConnector} connecting to ```unix:``` + *path* is served by the Unix domain socket, and one 
+		 * connecting to ```shm:``` + *path* by {@link SharedMemorySocket shared memory}. Clients are delivered to 
+		 * {@link addClient addClient()} as those of TCP, so that a server can be opened both by {@link open open()} and 
+		 * {@link openLocal openLocal()}.
+		 * 
+		 * As {@link open open()}, it blocks in the blocking mode and returns immediately in the asynchronous mode. A file 
+		 * left at the *path* is removed.
+		 * 
+		 * @param path Path of the Unix domain socket.
+		 * @throw std::invalid_argument The platform does not support Unix domain sockets.
+		 */
+		virtual void openLocal(const std::string &path)
+		{
+#ifdef SAMCHON_LOCAL_SOCKET
+			if (local_acceptor != nullptr && local_acceptor->is_open())
+				return;
+
+			// A FILE OF A SERVER WHICH HAS NOT CLOSED
+			::unlink(path.c_str());
+			local_path = path;
+
+			boost::asio::local::stream_protocol::endpoint endpoint(path);
+
+			// ASYNCHRONOUS MODE
+			if (service_pool != nullptr)
+			{
+				local_acceptor.reset(new boost::asio::local::stream_protocol::acceptor(service_pool->getService(), endpoint));
+				accept_local_async();
+
+				return;
+			}
+
+			// SOCKETS OUTLIVE THIS METHOD, THEN THEY HOLD THEIR SERVICE
+			std::shared_ptr<boost::asio::io_service> io_service(new boost::asio::io_service());
+			local_acceptor.reset(new boost::asio::local::stream_protocol::acceptor(*io_service, endpoint));
+
+			while (true)
+			{
+				std::shared_ptr<boost::asio::local::stream_protocol::socket> socket
+				(
+					new boost::asio::local::stream_protocol::socket(*io_service), 
+					[io_service](boost::asio::local::stream_protocol::socket *ptr)
+					{
+						delete ptr;
+					}
+				);
+				boost::system::error_code error;
+
+				local_acceptor->accept(*socket, error);
+				if (error)
+					break;
+
+				std::thread([this, socket]()
+				{
+					try
+					{
+						unsigned char length;
+						boost::asio::read(*socket, boost::asio::buffer(&length, 1));
+
+						std::string name(length, 0);
+						boost::asio::read(*socket, boost::asio::buffer(&name[0], name.size()));
+
+						handle_local_connection(socket, name);
+					}
+					catch (...)
+					{
+						// FAILED HANDSHAKE
+					}
+				}).detach();
+			}
+#else
+			throw std::invalid_argument("Unix domain sockets are not supported on this platform.");
+#endif
+		};
+
+		/**
+		 * Accept a client connected in memory.
+		 *
+		 * Delivers an end of a {@link LoopbackCommunicator} pair to {@link addClient addClient()}, as if a remote client
+		 * had connected, without opening the server. The pair must be created in the same mode with the server; by the
+		 * server's {@link IOServicePool} in the asynchronous mode. In the blocking mode, the *driver* is handled by a
+		 * thread of its own, as an accepted client is.
+		 *
+		 * @param driver An end of a {@link LoopbackCommunicator} pair.
+		 * @throw std::invalid_argument The *driver* works in the other mode.
+		 */
+		void accept(std::shared_ptr<ClientDriver> driver)
+		{
+			if (driver->isAsynchronous() != (service_pool != nullptr))
+				throw std::invalid_argument("The driver must work in the same mode with the server.");
+
+			if (service_pool != nullptr)
+				addClient(driver);
+			else
+				std::thread(&Server::addClient, this, driver).detach();
+		};
+
 		/**
 		 * Close the server.
 		 */
 		virtual void close()
 		{
+			close_acceptors();
+
+#ifdef SAMCHON_LOCAL_SOCKET
+			if (local_acceptor != nullptr && local_acceptor->is_open() == true)
+			{
+				boost::system::error_code error;
+				local_acceptor->cancel(error);
+				local_acceptor->close(error);
+
+				::unlink(local_path.c_str());
+			}
+#endif
+
 			if (_Acceptor == nullptr)
 				return;
 
@@ -127,9 +386,195 @@ namespace protocol
 		virtual void addClient(std::shared_ptr<ClientDriver>) = 0; //ADD_CLIENT
 
 	private:
-		virtual void handle_connection(std::shared_ptr<boost::asio::ip::tcp::socket> socket)
+		void listen(boost::asio::ip::tcp::acceptor &acceptor, const boost::asio::ip::tcp::endpoint &endpoint, bool reuse_port = false)
+		{
+			acceptor.open(endpoint.protocol());
+			acceptor.set_option(boost::asio::ip::tcp::acceptor::reuse_address(true));
+#ifdef SO_REUSEPORT
+			if (reuse_port == true)
+				acceptor.set_option(boost::asio::detail::socket_option::boolean<SOL_SOCKET, SO_REUSEPORT>(true));
+#endif
+
+			// BUFFER SIZES MUST PRECEDE THE LISTENING, FOR THE WINDOW SCALE OF ACCEPTED SOCKETS
+			socket_options.apply(acceptor);
+
+			acceptor.bind(endpoint);
+			acceptor.listen(socket_options.getBacklog());
+		};
+
+		void accept_async()
+		{
+			std::shared_ptr<boost::asio::ip::tcp::socket> socket(new boost::asio::ip::tcp::socket(service_pool->getService()));
+
+			_Acceptor->async_accept(*socket, [this, socket](const boost::system::error_code &error)
+			{
+				if (error)
+					return; // CLOSED
+
+				// KEEP ACCEPTING WHILE HANDLING THE NEW CLIENT
+				accept_async();
+
+				socket_options.apply(*socket);
+				handle_connection(service_pool->wrapSocket(socket));
+			});
+		};
+
+		/* ---------------------------------------------------------
+			MULTIPLE ACCEPTORS
+		--------------------------------------------------------- */
+		void open_acceptors(const boost::asio::ip::tcp::endpoint &endpoint)
 		{
-			addClient(std::make_shared<ClientDriver>(socket));
+			std::shared_ptr<AcceptorThread> first;
+			{
+				std::unique_lock<std::mutex> uk(acceptors_mutex);
+				if (acceptors.empty() == false)
+					return;
+
+				// BIND ALL BEFORE ACCEPTING, THEN A FAILURE LEAVES NOTHING RUNNING
+				std::vector<std::shared_ptr<AcceptorThread>> acceptors(acceptor_count);
+				for (size_t i = 0; i < acceptors.size(); i++)
+				{
+					acceptors[i].reset(new AcceptorThread());
+					listen(acceptors[i]->acceptor, endpoint, true);
+				}
+
+				// IN THE BLOCKING MODE, THE CALLER RUNS THE FIRST ACCEPTOR
+				for (size_t i = 0; i < acceptors.size(); i++)
+				{
+					std::shared_ptr<AcceptorThread> reactor = acceptors[i];
+					accept_async(reactor);
+
+					if (i != 0 || service_pool != nullptr)
+						reactor->thread = std::thread([reactor]()
+						{
+							reactor->service.run();
+						});
+				}
+				this->acceptors = std::move(acceptors);
+
+				if (service_pool != nullptr)
+					return;
+				first = this->acceptors.front();
+			}
+
+			first->service.run();
+			close_acceptors();
+		};
+
+		void accept_async(std::shared_ptr<AcceptorThread> reactor)
+		{
+			std::shared_ptr<boost::asio::ip::tcp::socket> socket;
+			if (service_pool != nullptr)
+				socket.reset(new boost::asio::ip::tcp::socket(service_pool->getService()));
+			else
+			{
+				// THE REACTOR OUTLIVES SOCKETS BORN IN IT
+				socket.reset(new boost::asio::ip::tcp::socket(reactor->service), [reactor](boost::asio::ip::tcp::socket *ptr)
+				{
+					delete ptr;
+				});
+			}
+
+			reactor->acceptor.async_accept(*socket, [this, reactor, socket](const boost::system::error_code &error)
+			{
+				if (error)
+					return; // CLOSED
+
+				accept_async(reactor);
+				socket_options.apply(*socket);
+
+				if (service_pool != nullptr)
+					handle_connection(service_pool->wrapSocket(socket));
+				else
+					std::thread(&Server::handle_connection, this, std::make_shared<StreamSocket<boost::asio::ip::tcp>>(socket)).detach();
+			});
+		};
+
+		void close_acceptors()
+		{
+			std::vector<std::thread> threads;
+			{
+				std::unique_lock<std::mutex> uk(acceptors_mutex);
+				for (auto it = acceptors.begin(); it != acceptors.end(); it++)
+				{
+					std::shared_ptr<AcceptorThread> reactor = *it;
+					reactor->service.post([reactor]()
+					{
+						reactor->acceptor.close();
+					});
+
+					if (reactor->thread.joinable() == true)
+						threads.push_back(std::move(reactor->thread));
+				}
+				acceptors.clear();
+			}
+
+			for (auto it = threads.begin(); it != threads.end(); it++)
+				if (it->get_id() == std::this_thread::get_id())
+					it->detach(); // CLOSED IN addClient()
+				else
+					it->join();
+		};
+
+#ifdef SAMCHON_LOCAL_SOCKET
+		/* ---------------------------------------------------------
+			LOCAL SERVER
+		--------------------------------------------------------- */
+		void accept_local_async()
+		{
+			std::shared_ptr<boost::asio::local::stream_protocol::socket> socket(new boost::asio::local::stream_protocol::socket(service_pool->getService()));
+
+			local_acceptor->async_accept(*socket, [this, socket](const boost::system::error_code &error)
+			{
+				if (error)
+					return; // CLOSED
+
+				accept_local_async();
+
+				// HEADER; LENGTH AND NAME OF A SHARED MEMORY SEGMENT
+				std::shared_ptr<std::string> name(new std::string());
+				std::shared_ptr<unsigned char> length(new unsigned char(0));
+
+				boost::asio::async_read(*socket, boost::asio::buffer(length.get(), 1), [this, socket, name, length](const boost::system::error_code &error, size_t)
+				{
+					if (error)
+						return;
+
+					name->resize(*length);
+					boost::asio::async_read(*socket, boost::asio::buffer(&(*name)[0], name->size()), [this, socket, name](const boost::system::error_code &error, size_t)
+					{
+						if (error)
+							return;
+
+						try
+						{
+							handle_local_connection(socket, *name);
+						}
+						catch (...)
+						{
+							// FAILED HANDSHAKE
+						}
+					});
+				});
+			});
+		};
+
+		void handle_local_connection(std::shared_ptr<boost::asio::local::stream_protocol::socket> socket, const std::string &name)
+		{
+			if (name.empty() == true)
+				handle_connection(std::make_shared<StreamSocket<boost::asio::local::stream_protocol>>(socket));
+			else
+				handle_connection(SharedMemorySocket::accept(socket, name));
+		};
+#endif
+
+		virtual void handle_connection(std::shared_ptr<Socket> socket)
+		{
+			std::shared_ptr<ClientDriver> driver(new ClientDriver(socket));
+			if (service_pool != nullptr)
+				driver->set_service_pool(service_pool);
+
+			addClient(driver);
 		};
 	};
 };
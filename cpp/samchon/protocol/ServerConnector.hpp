@@ -2,6 +2,8 @@
 #include <samchon/API.hpp>
 
 #include <samchon/protocol/Communicator.hpp>
+#include <samchon/protocol/SharedMemorySocket.hpp>
+#include <samchon/protocol/SocketOptions.hpp>
 
 namespace samchon
 {
@@ -28,6 +30,11 @@ namespace protocol
 	 * Samchon Framework's own | {@link ServerConnector}    | {@link Server}
 	 * Web-socket protocol     | {@link WebServerConnector} | {@link WebServer}
 	 * 
+	 * The transport is chosen by scheme of the address to {@link connect}. An IP address connects by TCP; 
+	 * ```unix:/path``` connects to a {@link Server.openLocal local server} by a Unix domain socket, and ```shm:/path``` 
+	 * by {@link SharedMemorySocket shared memory}, for systems on the same host. Code using the connector doesn't 
+	 * change, but the address it's given.
+	 * 
 	 * ![Basic Components](http://samchon.github.io/framework/images/design/cpp_class_diagram/protocol_basic_components.png)
 	 * 
 	 * @see {@link Server}, {@link IProtocol}
@@ -42,6 +49,26 @@ namespace protocol
 
 		std::unique_ptr<boost::asio::ip::tcp::endpoint> endpoint;
 
+		/**
+		 * Whether to offer the {@link InvokeCodec binary encoding} on connection.
+		 */
+		bool prefer_binary_encoding;
+
+		/**
+		 * Whether to offer compression on connection.
+		 */
+		bool prefer_compression;
+
+		/**
+		 * Options applied to the socket before connecting.
+		 */
+		SocketOptions socket_options;
+
+		/**
+		 * Bytes of the shared memory ring of each direction, for ```shm:``` addresses.
+		 */
+		size_t shared_memory_size;
+
 	public:
 		/* -----------------------------------------------------------
 			CONSTRUCTORS
@@ -55,6 +82,9 @@ namespace protocol
 		ServerConnector(IProtocol *listener)
 		{
 			this->listener = listener;
+			this->prefer_binary_encoding = false;
+			this->prefer_compression = false;
+			this->shared_memory_size = 4 * 1024 * 1024;
 		};
 		
 		/**
@@ -62,6 +92,94 @@ namespace protocol
 		 */
 		virtual ~ServerConnector() = default;
 
+		/**
+		 * Prefer the binary encoding.
+		 * 
+		 * Configures whether to offer the {@link InvokeCodec binary encoding} to the server on {@link connect connection}.
+		 * When the server accepts the offer, {@link Invoke} messages are sent in the binary encoding instead of XML, 
+		 * which saves the cost of building and parsing XML documents. A server following XML only ignores the offer, 
+		 * and then both sides keep using XML.
+		 * 
+		 * The offer is an {@link Invoke} message of the listener ```_Offer_encoding```. A server of a former version, 
+		 * who doesn't know the negotiation, delivers it to its listener as an ordinary message; enable it only if 
+		 * the server's listener ignores unknown messages.
+		 * 
+		 * @param flag Whether to offer the binary encoding. Default is ```false```.
+		 */
+		void setBinaryEncoding(bool flag)
+		{
+			prefer_binary_encoding = flag;
+		};
+
+		/**
+		 * Prefer compression.
+		 * 
+		 * Configures whether to offer compression to the server on {@link connect connection}. When the server accepts 
+		 * the offer, frames of {@link Invoke} messages and their *ByteArray* parameters larger than the *threshold* are 
+		 * compressed by zlib, in both directions. It saves bandwidth for text-heavy messages, at cost of CPU. A server 
+		 * who doesn't know the compression ignores the offer.
+		 * 
+		 * The offer is delivered to the listener of a server of a former version, as {@link setBinaryEncoding} is.
+		 * 
+		 * @param flag Whether to offer compression. Default is ```false```.
+		 * @param threshold Frames smaller than it are not compressed.
+		 */
+		void setCompression(bool flag, size_t threshold = 1024)
+		{
+			prefer_compression = flag;
+			compression_threshold = threshold;
+		};
+
+		/**
+		 * Set I/O service pool.
+		 * 
+		 * Switches the {@link ServerConnector} to the asynchronous mode, driven by the *pool*'s threads. Then 
+		 * {@link connect connect()} returns immediately after the connection has succeeded; use {@link onClose} to be
+		 * notified of disconnection. In the asynchronous mode, the {@link ServerConnector} must be owned by a 
+		 * ```std::shared_ptr```. It must be called before {@link connect connecting}.
+		 * 
+		 * @param pool An {@link IOServicePool} to drive the connection.
+		 */
+		void setIOServicePool(std::shared_ptr<IOServicePool> pool)
+		{
+			set_service_pool(pool);
+		};
+
+		/**
+		 * Set socket options.
+		 * 
+		 * The *options* are applied to the socket before connecting, so that buffer sizes take effect on the window 
+		 * scale negotiated. It must be called before {@link connect connecting}.
+		 * 
+		 * @param options {@link SocketOptions} to apply.
+		 */
+		void setSocketOptions(const SocketOptions &options)
+		{
+			socket_options = options;
+		};
+
+		/**
+		 * Get socket options.
+		 */
+		auto getSocketOptions() const -> const SocketOptions&
+		{
+			return socket_options;
+		};
+
+		/**
+		 * Set size of shared memory.
+		 * 
+		 * Configures bytes of the {@link SharedMemoryRing ring} of each direction, when connecting to a ```shm:``` 
+		 * address. A larger ring lets a bulk message go at once, without waiting for the remote system to consume. It 
+		 * must be called before {@link connect connecting}.
+		 * 
+		 * @param size Bytes of each ring, rounded up to a power of 2. Default is 4 MB.
+		 */
+		void setSharedMemorySize(size_t size)
+		{
+			shared_memory_size = size;
+		};
+
 		/* -----------------------------------------------------------
 			CONNECTOR
 		----------------------------------------------------------- */
@@ -81,14 +199,17 @@ namespace protocol
 		 * @param ip The name or IP address of the host to connect to. 
 		 *			 If no host is specified, the host that is contacted is the host where the calling file resides. 
 		 *			 If you do not specify a host, use an event listener to determine whether the connection was 
-		 *			 successful.
-		 * @param port The port number to connect to.
+		 *			 successful. ```unix:/path``` and ```shm:/path``` connect to a local server at the *path*.
+		 * @param port The port number to connect to, ignored for a local server.
 		 */
 		virtual void connect(const std::string &ip, int port)
 		{
 			_Connect(ip, port);
 
-			listen_message();
+			if (prefer_binary_encoding == true || prefer_compression == true)
+				offer_encodings(prefer_binary_encoding, prefer_compression);
+
+			start_listening();
 		};
 
 	protected:
@@ -97,11 +218,52 @@ namespace protocol
 			if (socket != nullptr && socket->is_open() == true)
 				throw std::logic_error("Already connected");
 
-			io_service.reset(new boost::asio::io_service());
+			if (service_pool == nullptr)
+				io_service.reset(new boost::asio::io_service());
+			boost::asio::io_service &service = (service_pool != nullptr) ? service_pool->getService() : *io_service;
+
+			// LOCAL SERVER
+			if (ip.compare(0, 5, "unix:") == 0 || ip.compare(0, 4, "shm:") == 0)
+			{
+				connect_local(service, ip);
+				return;
+			}
+
 			endpoint.reset(new boost::asio::ip::tcp::endpoint(boost::asio::ip::address::from_string(ip), port));
 
-			socket.reset(new boost::asio::ip::tcp::socket(*io_service, boost::asio::ip::tcp::v4()));
-			socket->connect(*endpoint);
+			std::shared_ptr<boost::asio::ip::tcp::socket> tcp_socket(new boost::asio::ip::tcp::socket(service, boost::asio::ip::tcp::v4()));
+			socket_options.apply(*tcp_socket);
+			tcp_socket->connect(*endpoint);
+
+			if (service_pool != nullptr)
+				socket = service_pool->wrapSocket(tcp_socket);
+			else
+				socket.reset(new StreamSocket<boost::asio::ip::tcp>(tcp_socket));
+		};
+
+	private:
+		void connect_local(boost::asio::io_service &service, const std::string &address)
+		{
+#ifdef SAMCHON_LOCAL_SOCKET
+			bool shared_memory = (address.front() == 's');
+			std::string path = address.substr(address.find(':') + 1);
+
+			std::shared_ptr<boost::asio::local::stream_protocol::socket> local_socket(new boost::asio::local::stream_protocol::socket(service));
+			local_socket->connect(boost::asio::local::stream_protocol::endpoint(path));
+
+			if (shared_memory == true)
+				socket = SharedMemorySocket::connect(local_socket, shared_memory_size);
+			else
+			{
+				// HEADER WITHOUT SHARED MEMORY
+				unsigned char header = 0;
+				boost::asio::write(*local_socket, boost::asio::buffer(&header, 1));
+
+				socket.reset(new StreamSocket<boost::asio::local::stream_protocol>(local_socket));
+			}
+#else
+			throw std::invalid_argument("Unix domain sockets are not supported on this platform: " + address);
+#endif
 		};
 	};
 };
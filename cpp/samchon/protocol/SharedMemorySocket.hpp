@@ -0,0 +1,537 @@
+#pragma once
+#include <samchon/API.hpp>
+
+#include <samchon/protocol/Socket.hpp>
+
+/* -------------------------------------------------------------------------
+	UNIX DOMAIN SOCKETS AND POSIX SHARED MEMORY, IF THE PLATFORM SUPPORTS
+------------------------------------------------------------------------- */
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS) && !defined(_WIN32)
+#	define SAMCHON_LOCAL_SOCKET 1
+#endif
+
+#ifdef SAMCHON_LOCAL_SOCKET
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace samchon
+{
+namespace protocol
+{
+	/**
+	 * A ring of bytes in shared memory, of a single producer and a single consumer.
+	 *
+	 * The {@link SharedMemoryRing} is a header placed in front of its data, in a shared memory segment. Positions of
+	 * the producer and the consumer grow monotonically, and their difference is number of bytes stored.
+	 *
+	 * @author Jeongho Nam <http://samchon.org>
+	 */
+	struct SharedMemoryRing
+	{
+		/**
+		 * Position of the consumer.
+		 */
+		alignas(64) std::atomic<unsigned long long> head;
+
+		/**
+		 * Position of the producer.
+		 */
+		alignas(64) std::atomic<unsigned long long> tail;
+
+		/**
+		 * Whether the consumer is waiting for a doorbell.
+		 */
+		alignas(64) std::atomic<unsigned int> sleeping;
+
+		/**
+		 * Whether either side has closed the ring.
+		 */
+		std::atomic<unsigned int> closed;
+
+		/**
+		 * Capacity of the data, a power of 2.
+		 */
+		unsigned long long capacity;
+
+		/**
+		 * Initialize the ring, in a newly created segment.
+		 */
+		void construct(unsigned long long capacity)
+		{
+			head = 0;
+			tail = 0;
+			sleeping = 0;
+			closed = 0;
+
+			this->capacity = capacity;
+		};
+
+		/**
+		 * Get the data following the header.
+		 */
+		auto data() -> unsigned char*
+		{
+			return reinterpret_cast<unsigned char*>(this) + sizeof(SharedMemoryRing);
+		};
+
+		/**
+		 * Test whether the ring is empty, by the consumer.
+		 */
+		auto empty() const -> bool
+		{
+			return head.load(std::memory_order_relaxed) == tail.load(std::memory_order_seq_cst);
+		};
+
+		/**
+		 * Store bytes of buffers, as many as the space takes.
+		 *
+		 * @return Number of bytes stored.
+		 */
+		auto push(const boost::asio::const_buffer *buffers, size_t count) -> size_t
+		{
+			unsigned long long tail = this->tail.load(std::memory_order_relaxed);
+			unsigned long long space = capacity - (tail - head.load(std::memory_order_acquire));
+
+			size_t size = 0;
+			for (size_t i = 0; i < count && space != 0; i++)
+			{
+				size_t piece = (size_t)std::min<unsigned long long>(buffers[i].size(), space);
+				copy_in(tail + size, (const unsigned char*)buffers[i].data(), piece);
+
+				size += piece;
+				space -= piece;
+			}
+
+			// PUBLISH, THEN SEE WHETHER THE CONSUMER SLEEPS
+			this->tail.store(tail + size, std::memory_order_release);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+
+			return size;
+		};
+
+		/**
+		 * Take bytes, as many as stored.
+		 *
+		 * @return Number of bytes taken.
+		 */
+		auto pop(unsigned char *data, size_t size) -> size_t
+		{
+			unsigned long long head = this->head.load(std::memory_order_relaxed);
+			size = (size_t)std::min<unsigned long long>(size, tail.load(std::memory_order_acquire) - head);
+
+			if (size != 0)
+			{
+				copy_out(head, data, size);
+				this->head.store(head + size, std::memory_order_release);
+			}
+			return size;
+		};
+
+	private:
+		void copy_in(unsigned long long position, const unsigned char *data, size_t size)
+		{
+			size_t offset = (size_t)(position & (capacity - 1));
+			size_t first = std::min<size_t>(size, (size_t)capacity - offset);
+
+			std::memcpy(this->data() + offset, data, first);
+			std::memcpy(this->data(), data + first, size - first);
+		};
+
+		void copy_out(unsigned long long position, unsigned char *data, size_t size)
+		{
+			size_t offset = (size_t)(position & (capacity - 1));
+			size_t first = std::min<size_t>(size, (size_t)capacity - offset);
+
+			std::memcpy(data, this->data() + offset, first);
+			std::memcpy(data + first, this->data(), size - first);
+		};
+	};
+
+	/**
+	 * A {@link Socket} of shared memory, for systems on the same host.
+	 *
+	 * The {@link SharedMemorySocket} carries bytes through a pair of {@link SharedMemoryRing rings} in a shared memory
+	 * segment, one for each direction, so that a frame goes to the remote system by a copy into the ring and a copy out
+	 * of it, without any system call. A Unix domain socket is kept as a *doorbell*: a producer writes a byte on it only
+	 * when the consumer has slept for an empty ring, and tells disconnection by its closing. A producer facing a full
+	 * ring polls the consumer with a backoff.
+	 *
+	 * The segment is created by the connecting side, named after its process, and removed from the file system as soon
+	 * as the accepting side has mapped it; it can't outlive the two systems.
+	 *
+	 * A connection to a local server, opened by {@link Server.openLocal}, begins with a header telling its transport;
+	 * a byte of length and the name of segment, or a zero byte for the plain Unix domain socket.
+	 *
+	 * @see {@link ServerConnector}, {@link Server.openLocal}
+	 * @author Jeongho Nam <http://samchon.org>
+	 */
+	class SharedMemorySocket
+		: public Socket
+	{
+	public:
+		typedef boost::asio::local::stream_protocol::socket doorbell_type;
+
+	private:
+		std::shared_ptr<doorbell_type> doorbell;
+
+		void *segment;
+		size_t segment_size;
+
+		SharedMemoryRing *inbound;
+		SharedMemoryRing *outbound;
+
+		std::atomic<bool> closed;
+
+		// BYTES OF THE DOORBELL, READ BY THE CONSUMER
+		unsigned char chimes[64];
+
+	public:
+		/* ---------------------------------------------------------
+			CONSTRUCTORS
+		--------------------------------------------------------- */
+		/**
+		 * Connect through a Unix domain socket.
+		 *
+		 * Creates a segment, tells the remote system its name, and waits for the remote system to map it.
+		 *
+		 * @param doorbell A Unix domain socket connected to a local server.
+		 * @param capacity Bytes of the ring of each direction. It's rounded up to a power of 2.
+		 */
+		static auto connect(std::shared_ptr<doorbell_type> doorbell, size_t capacity) -> std::shared_ptr<SharedMemorySocket>
+		{
+			static std::atomic<size_t> sequence(0);
+
+			std::string name = "/samchon-" + std::to_string(::getpid()) + "-" + std::to_string(++sequence)
+				+ "-" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count() & 0xffffff);
+
+			// ROUND UP TO A POWER OF 2
+			unsigned long long ring_capacity = 4096;
+			while (ring_capacity < capacity)
+				ring_capacity <<= 1;
+
+			int fd = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+			if (fd == -1)
+				throw boost::system::system_error(errno, boost::system::system_category(), "shm_open");
+
+			size_t size = 2 * (sizeof(SharedMemoryRing) + ring_capacity);
+			void *segment = (::ftruncate(fd, size) == 0)
+				? ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0)
+				: MAP_FAILED;
+			int error = errno;
+			::close(fd);
+
+			if (segment == MAP_FAILED)
+			{
+				::shm_unlink(name.c_str());
+				throw boost::system::system_error(error, boost::system::system_category(), "mmap");
+			}
+
+			std::shared_ptr<SharedMemorySocket> socket(new SharedMemorySocket(doorbell, segment, size, false));
+			socket->outbound->construct(ring_capacity);
+			socket->inbound->construct(ring_capacity);
+
+			// TELL THE NAME, THEN WAIT FOR THE REMOTE SYSTEM TO MAP
+			try
+			{
+				unsigned char header = (unsigned char)name.size();
+				unsigned char ack;
+
+				boost::asio::write(*doorbell, std::vector<boost::asio::const_buffer>({ boost::asio::buffer(&header, 1), boost::asio::buffer(name) }));
+				boost::asio::read(*doorbell, boost::asio::buffer(&ack, 1));
+			}
+			catch (...)
+			{
+				::shm_unlink(name.c_str());
+				throw;
+			}
+			::shm_unlink(name.c_str());
+
+			return socket;
+		};
+
+		/**
+		 * Accept through a Unix domain socket.
+		 *
+		 * Maps the segment created by the remote system, and tells the remote system it has been mapped.
+		 *
+		 * @param doorbell A Unix domain socket accepted by a local server.
+		 * @param name Name of the segment, read from the header of the connection.
+		 * @throw boost::system::system_error If the segment can't be mapped, or its rings are not laid out by
+		 *		  {@link connect connect()}.
+		 */
+		static auto accept(std::shared_ptr<doorbell_type> doorbell, const std::string &name) -> std::shared_ptr<SharedMemorySocket>
+		{
+			int fd = ::shm_open(name.c_str(), O_RDWR, 0600);
+			if (fd == -1)
+				throw boost::system::system_error(errno, boost::system::system_category(), "shm_open");
+
+			struct stat status;
+			void *segment = (::fstat(fd, &status) == 0 && status.st_size > (off_t)(2 * sizeof(SharedMemoryRing)))
+				? ::mmap(nullptr, (size_t)status.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0)
+				: MAP_FAILED;
+			int error = errno;
+			::close(fd);
+
+			if (segment == MAP_FAILED)
+				throw boost::system::system_error(error, boost::system::system_category(), "mmap");
+
+			// REFUSE A SEGMENT NOT LAID OUT BY connect()
+			size_t half = (size_t)status.st_size / 2;
+			if (is_ring(segment, 0, half) == false || is_ring(segment, half, half) == false)
+			{
+				::munmap(segment, (size_t)status.st_size);
+				throw boost::system::system_error(boost::asio::error::invalid_argument, "malformed shared memory segment");
+			}
+
+			std::shared_ptr<SharedMemorySocket> socket(new SharedMemorySocket(doorbell, segment, (size_t)status.st_size, true));
+
+			unsigned char ack = 1;
+			boost::asio::write(*doorbell, boost::asio::buffer(&ack, 1));
+
+			return socket;
+		};
+
+		virtual ~SharedMemorySocket()
+		{
+			boost::system::error_code error;
+			close(error);
+
+			::munmap(segment, segment_size);
+		};
+
+	private:
+		static auto is_ring(const void *segment, size_t offset, size_t half) -> bool
+		{
+			if (half % alignof(SharedMemoryRing) != 0 || half <= sizeof(SharedMemoryRing))
+				return false;
+
+			// A POWER OF 2, FILLING ITS HALF OF THE SEGMENT
+			unsigned long long capacity = reinterpret_cast<const SharedMemoryRing*>((const unsigned char*)segment + offset)->capacity;
+
+			return (capacity & (capacity - 1)) == 0 && capacity == half - sizeof(SharedMemoryRing);
+		};
+
+		SharedMemorySocket(std::shared_ptr<doorbell_type> doorbell, void *segment, size_t segment_size, bool accepted)
+			: doorbell(doorbell), segment(segment), segment_size(segment_size), closed(false)
+		{
+			// THE CONNECTING SIDE WRITES THE FIRST RING
+			SharedMemoryRing *first = reinterpret_cast<SharedMemoryRing*>(segment);
+			SharedMemoryRing *second = reinterpret_cast<SharedMemoryRing*>((unsigned char*)segment + segment_size / 2);
+
+			inbound = accepted ? first : second;
+			outbound = accepted ? second : first;
+		};
+
+	public:
+		virtual void close(boost::system::error_code &error) override
+		{
+			if (closed.exchange(true) == true)
+				return;
+
+			// BOTH RINGS, THEN THE REMOTE PRODUCER STOPS TOO
+			inbound->closed = 1;
+			outbound->closed = 1;
+
+			// WAKES UP BLOCKED READERS OF BOTH SIDES
+			boost::system::error_code ignored;
+			doorbell->shutdown(boost::asio::socket_base::shutdown_both, ignored);
+			doorbell->close(error);
+		};
+
+		/* ---------------------------------------------------------
+			ACCESSORS
+		--------------------------------------------------------- */
+		virtual auto get_executor() -> executor_type override
+		{
+			return doorbell->get_executor();
+		};
+
+		virtual auto is_open() const -> bool override
+		{
+			return closed == false;
+		};
+
+		/**
+		 * Get bytes of the ring of each direction.
+		 */
+		auto capacity() const -> size_t
+		{
+			return (size_t)outbound->capacity;
+		};
+
+	protected:
+		/* ---------------------------------------------------------
+			READ
+		--------------------------------------------------------- */
+		virtual auto read_bytes(boost::asio::mutable_buffer buffer, boost::system::error_code &error) -> size_t override
+		{
+			while (true)
+			{
+				size_t size = inbound->pop((unsigned char*)buffer.data(), buffer.size());
+				if (size != 0 || buffer.size() == 0 || test_closed(error) == true)
+					return size;
+				else if (sleep() == false)
+					continue;
+
+				doorbell->read_some(boost::asio::buffer(chimes), error);
+				inbound->sleeping = 0;
+
+				// DRAIN BYTES WRITTEN BEFORE THE DISCONNECTION
+				if (error && inbound->empty() == true)
+				{
+					if (error != boost::asio::error::operation_aborted)
+						error = boost::asio::error::eof;
+					return 0;
+				}
+				error.clear();
+			}
+		};
+
+		virtual void async_read_bytes(boost::asio::mutable_buffer buffer, Handler handler) override
+		{
+			boost::system::error_code error;
+
+			size_t size = inbound->pop((unsigned char*)buffer.data(), buffer.size());
+			if (size == 0 && buffer.size() != 0 && test_closed(error) == false)
+			{
+				if (sleep() == false)
+				{
+					async_read_bytes(buffer, handler);
+					return;
+				}
+
+				doorbell->async_read_some(boost::asio::buffer(chimes), [this, buffer, handler](const boost::system::error_code &error, size_t)
+				{
+					inbound->sleeping = 0;
+
+					if (error && inbound->empty() == true)
+						handler((error == boost::asio::error::operation_aborted) ? error : boost::asio::error::eof, 0);
+					else
+						async_read_bytes(buffer, handler);
+				});
+				return;
+			}
+
+			boost::asio::post(get_executor(), [handler, error, size]()
+			{
+				handler(error, size);
+			});
+		};
+
+		/* ---------------------------------------------------------
+			WRITE
+		--------------------------------------------------------- */
+		virtual auto write_bytes(const boost::asio::const_buffer *buffers, size_t count, boost::system::error_code &error) -> size_t override
+		{
+			for (size_t attempt = 0; ; attempt++)
+			{
+				size_t size = push(buffers, count, error);
+				if (size != 0 || error)
+					return size;
+
+				// FULL, POLL THE CONSUMER
+				if (attempt < 64)
+					std::this_thread::yield();
+				else
+					std::this_thread::sleep_for(backoff(attempt - 64));
+			}
+		};
+
+		virtual void async_write_bytes(std::vector<boost::asio::const_buffer> buffers, Handler handler) override
+		{
+			async_write_bytes(std::move(buffers), handler, 0);
+		};
+
+	private:
+		void async_write_bytes(std::vector<boost::asio::const_buffer> buffers, Handler handler, size_t attempt)
+		{
+			boost::system::error_code error;
+
+			size_t size = push(buffers.data(), buffers.size(), error);
+			if (size == 0 && !error)
+			{
+				// FULL, POLL THE CONSUMER BY A TIMER
+				std::shared_ptr<boost::asio::steady_timer> timer(new boost::asio::steady_timer(get_executor()));
+				timer->expires_after(backoff(attempt));
+				timer->async_wait([this, timer, buffers, handler, attempt](const boost::system::error_code &)
+				{
+					async_write_bytes(buffers, handler, attempt + 1);
+				});
+				return;
+			}
+
+			boost::asio::post(get_executor(), [handler, error, size]()
+			{
+				handler(error, size);
+			});
+		};
+
+		/* ---------------------------------------------------------
+			SIGNALS
+		--------------------------------------------------------- */
+		auto push(const boost::asio::const_buffer *buffers, size_t count, boost::system::error_code &error) -> size_t
+		{
+			if (closed == true)
+			{
+				error = boost::asio::error::bad_descriptor;
+				return 0;
+			}
+			else if (outbound->closed != 0)
+			{
+				error = boost::asio::error::broken_pipe;
+				return 0;
+			}
+
+			size_t size = outbound->push(buffers, count);
+
+			// RING THE DOORBELL OF A SLEEPING CONSUMER
+			if (size != 0 && outbound->sleeping.exchange(0) == 1)
+			{
+				unsigned char chime = 1;
+				boost::system::error_code ignored;
+
+				doorbell->write_some(boost::asio::buffer(&chime, 1), ignored);
+			}
+			return size;
+		};
+
+		auto test_closed(boost::system::error_code &error) const -> bool
+		{
+			if (closed == true)
+				error = boost::asio::error::operation_aborted;
+			else if (inbound->closed != 0 && inbound->empty() == true)
+				error = boost::asio::error::eof;
+			else
+				return false;
+
+			return true;
+		};
+
+		auto sleep() -> bool
+		{
+			// THE PRODUCER SEES EITHER THE FLAG, OR THE CONSUMER SEES THE BYTES
+			inbound->sleeping.store(1, std::memory_order_seq_cst);
+			if (inbound->empty() == true && inbound->closed == 0)
+				return true;
+
+			inbound->sleeping = 0;
+			return false;
+		};
+
+		static auto backoff(size_t attempt) -> std::chrono::microseconds
+		{
+			return std::chrono::microseconds(std::min<size_t>(1000, (size_t)10 << std::min<size_t>(attempt, 7)));
+		};
+	};
+};
+};
+#endif
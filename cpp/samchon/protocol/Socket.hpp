@@ -0,0 +1,281 @@
+#pragma once
+#include <samchon/API.hpp>
+
+#include <array>
+#include <functional>
+#include <memory>
+#include <vector>
+#include <boost/asio.hpp>
+
+namespace samchon
+{
+namespace protocol
+{
+	/**
+	 * A stream socket of any transport.
+	 *
+	 * The {@link Socket} is a byte stream between a {@link Communicator} and its remote system, hiding which transport
+	 * carries the bytes. It follows the stream concepts of ```boost::asio```, so that ```boost::asio::read()```,
+	 * ```boost::asio::async_write()``` and the others work on it as they do on a TCP socket.
+	 *
+	 * The transport is chosen by scheme of the address given to {@link ServerConnector.connect}.
+	 *
+	 * Transport		| Address			| Derived Type
+	 * -----------------|-------------------|---------------------------
+	 * TCP				| ```127.0.0.1```	| {@link StreamSocket}
+	 * Unix domain		| ```unix:/path```	| {@link StreamSocket}
+	 * Shared memory	| ```shm:/path```	| {@link SharedMemorySocket}
+	 *
+	 * @see {@link Communicator}
+	 * @author Jeongho Nam <http://samchon.org>
+	 */
+	class Socket
+	{
+	public:
+		typedef boost::asio::ip::tcp::socket::executor_type executor_type;
+
+		/**
+		 * A function called with result of an asynchronous operation, and bytes transferred.
+		 */
+		typedef std::function<void(const boost::system::error_code&, size_t)> Handler;
+
+	public:
+		/* ---------------------------------------------------------
+			CONSTRUCTORS
+		--------------------------------------------------------- */
+		Socket() = default;
+		Socket(const Socket &) = delete;
+
+		virtual ~Socket() = default;
+
+		/**
+		 * Close the socket.
+		 *
+		 * Pending asynchronous operations are completed with ```boost::asio::error::operation_aborted```.
+		 */
+		virtual void close(boost::system::error_code &error) = 0;
+
+		/**
+		 * Close the socket, throwing an error.
+		 */
+		void close()
+		{
+			boost::system::error_code error;
+			close(error);
+
+			if (error)
+				throw boost::system::system_error(error);
+		};
+
+		/* ---------------------------------------------------------
+			ACCESSORS
+		--------------------------------------------------------- */
+		/**
+		 * Get executor running the asynchronous operations.
+		 */
+		virtual auto get_executor() -> executor_type = 0;
+
+		/**
+		 * Test whether the socket is open.
+		 */
+		virtual auto is_open() const -> bool = 0;
+
+		/* ---------------------------------------------------------
+			READ
+		--------------------------------------------------------- */
+		template <typename MutableBufferSequence>
+		auto read_some(const MutableBufferSequence &buffers) -> size_t
+		{
+			boost::system::error_code error;
+			size_t size = read_some(buffers, error);
+
+			if (error)
+				throw boost::system::system_error(error);
+			return size;
+		};
+
+		template <typename MutableBufferSequence>
+		auto read_some(const MutableBufferSequence &buffers, boost::system::error_code &error) -> size_t
+		{
+			return read_bytes(first_buffer<boost::asio::mutable_buffer>(buffers), error);
+		};
+
+		template <typename MutableBufferSequence, typename ReadHandler>
+		void async_read_some(const MutableBufferSequence &buffers, ReadHandler &&handler)
+		{
+			async_read_bytes(first_buffer<boost::asio::mutable_buffer>(buffers), Handler(std::forward<ReadHandler>(handler)));
+		};
+
+		/* ---------------------------------------------------------
+			WRITE
+		--------------------------------------------------------- */
+		template <typename ConstBufferSequence>
+		auto write_some(const ConstBufferSequence &buffers) -> size_t
+		{
+			boost::system::error_code error;
+			size_t size = write_some(buffers, error);
+
+			if (error)
+				throw boost::system::system_error(error);
+			return size;
+		};
+
+		template <typename ConstBufferSequence>
+		auto write_some(const ConstBufferSequence &buffers, boost::system::error_code &error) -> size_t
+		{
+			// AS MANY AS AN IOVEC TAKES, THE REST ARE WRITTEN BY THE NEXT CALL
+			std::array<boost::asio::const_buffer, 64> array;
+			size_t count = 0;
+
+			for (auto it = boost::asio::buffer_sequence_begin(buffers); it != boost::asio::buffer_sequence_end(buffers) && count < array.size(); it++)
+				array[count++] = boost::asio::const_buffer(*it);
+
+			return write_bytes(array.data(), count, error);
+		};
+
+		template <typename ConstBufferSequence, typename WriteHandler>
+		void async_write_some(const ConstBufferSequence &buffers, WriteHandler &&handler)
+		{
+			std::vector<boost::asio::const_buffer> vec;
+			for (auto it = boost::asio::buffer_sequence_begin(buffers); it != boost::asio::buffer_sequence_end(buffers) && vec.size() < 64; it++)
+				vec.emplace_back(*it);
+
+			async_write_bytes(std::move(vec), Handler(std::forward<WriteHandler>(handler)));
+		};
+
+	protected:
+		/* ---------------------------------------------------------
+			TRANSPORT
+		--------------------------------------------------------- */
+		/**
+		 * Read some bytes, blocking until at least one byte has been read.
+		 */
+		virtual auto read_bytes(boost::asio::mutable_buffer buffer, boost::system::error_code &error) -> size_t = 0;
+
+		/**
+		 * Start reading some bytes.
+		 *
+		 * The *handler* must not be called before this method returns.
+		 */
+		virtual void async_read_bytes(boost::asio::mutable_buffer buffer, Handler handler) = 0;
+
+		/**
+		 * Write some bytes of the *buffers*, blocking until at least one byte has been written.
+		 */
+		virtual auto write_bytes(const boost::asio::const_buffer *buffers, size_t count, boost::system::error_code &error) -> size_t = 0;
+
+		/**
+		 * Start writing some bytes of the *buffers*.
+		 *
+		 * The *handler* must not be called before this method returns.
+		 */
+		virtual void async_write_bytes(std::vector<boost::asio::const_buffer> buffers, Handler handler) = 0;
+
+	private:
+		template <typename Buffer, typename BufferSequence>
+		static auto first_buffer(const BufferSequence &buffers) -> Buffer
+		{
+			for (auto it = boost::asio::buffer_sequence_begin(buffers); it != boost::asio::buffer_sequence_end(buffers); it++)
+				if (boost::asio::buffer_size(*it) != 0)
+					return Buffer(*it);
+
+			return Buffer();
+		};
+	};
+
+	/**
+	 * A {@link Socket} of ```boost::asio```, TCP or Unix domain.
+	 *
+	 * @tparam Protocol A stream protocol, ```boost::asio::ip::tcp``` or ```boost::asio::local::stream_protocol```.
+	 * @author Jeongho Nam <http://samchon.org>
+	 */
+	template <typename Protocol>
+	class StreamSocket
+		: public Socket
+	{
+	public:
+		typedef typename Protocol::socket socket_type;
+
+	private:
+		std::shared_ptr<socket_type> socket;
+
+	public:
+		/**
+		 * Construct from a connected socket.
+		 */
+		StreamSocket(std::shared_ptr<socket_type> socket)
+			: socket(socket)
+		{
+		};
+
+		virtual void close(boost::system::error_code &error) override
+		{
+			socket->close(error);
+		};
+
+		/**
+		 * Get the underlying socket.
+		 */
+		auto get() const -> std::shared_ptr<socket_type>
+		{
+			return socket;
+		};
+
+		virtual auto get_executor() -> executor_type override
+		{
+			return socket->get_executor();
+		};
+
+		virtual auto is_open() const -> bool override
+		{
+			return socket->is_open();
+		};
+
+	protected:
+		virtual auto read_bytes(boost::asio::mutable_buffer buffer, boost::system::error_code &error) -> size_t override
+		{
+			return socket->read_some(buffer, error);
+		};
+
+		virtual void async_read_bytes(boost::asio::mutable_buffer buffer, Handler handler) override
+		{
+			socket->async_read_some(buffer, std::move(handler));
+		};
+
+		virtual auto write_bytes(const boost::asio::const_buffer *buffers, size_t count, boost::system::error_code &error) -> size_t override
+		{
+			return socket->write_some(BufferRange(buffers, count), error);
+		};
+
+		virtual void async_write_bytes(std::vector<boost::asio::const_buffer> buffers, Handler handler) override
+		{
+			socket->async_write_some(buffers, std::move(handler));
+		};
+
+	private:
+		// A SEQUENCE OF BUFFERS IN PLACE
+		struct BufferRange
+		{
+			typedef boost::asio::const_buffer value_type;
+			typedef const boost::asio::const_buffer *const_iterator;
+
+			const_iterator first;
+			const_iterator last;
+
+			BufferRange(const_iterator data, size_t count)
+				: first(data), last(data + count)
+			{
+			};
+
+			auto begin() const -> const_iterator
+			{
+				return first;
+			};
+			auto end() const -> const_iterator
+			{
+				return last;
+			};
+		};
+	};
+};
+};
@@ -0,0 +1,187 @@
+#pragma once
+#include <samchon/API.hpp>
+
+#include <boost/asio.hpp>
+
+namespace samchon
+{
+namespace protocol
+{
+	/**
+	 * Options of TCP sockets.
+	 *
+	 * The {@link SocketOptions} is applied to every socket accepted by a {@link Server} and connected by a
+	 * {@link ServerConnector}, including their web-socket variants. Deliver it by ```setSocketOptions()``` before
+	 * opening the server or connecting.
+	 *
+	 * By default, only *TCP_NODELAY* is set. {@link Communicator} coalesces queued messages into large writes by itself,
+	 * so that Nagle's algorithm only delays small messages, like a control {@link Invoke} waiting for the delayed ACK of
+	 * the previous one. Zero for the other options means the system's default.
+	 *
+	 * Options are applied on a best-effort basis; an option not supported by the platform, or refused by the system,
+	 * is ignored.
+	 *
+	 * @code
+	 * protocol::SocketOptions options;
+	 * options.receive_buffer_size = 4 * 1024 * 1024;
+	 * options.keep_alive = true;
+	 * options.keep_alive_idle = 30;
+	 *
+	 * server->setSocketOptions(options);
+	 * server->open(port);
+	 * @endcode
+	 *
+	 * @see {@link Server}, {@link ServerConnector}
+	 * @author Jeongho Nam <http://samchon.org>
+	 */
+	struct SocketOptions
+	{
+		/**
+		 * *TCP_NODELAY*, disabling Nagle's algorithm. Default is ```true```.
+		 */
+		bool no_delay;
+
+		/**
+		 * *SO_SNDBUF*, size of the kernel's send buffer in bytes.
+		 */
+		int send_buffer_size;
+
+		/**
+		 * *SO_RCVBUF*, size of the kernel's receive buffer in bytes.
+		 *
+		 * It's applied to the listening socket as well, for the window scale negotiated on accepting.
+		 */
+		int receive_buffer_size;
+
+		/**
+		 * *SO_KEEPALIVE*, probing an idle connection to detect a dead peer.
+		 */
+		bool keep_alive;
+
+		/**
+		 * *TCP_KEEPIDLE*, seconds of idleness before the first probe.
+		 */
+		int keep_alive_idle;
+
+		/**
+		 * *TCP_KEEPINTVL*, seconds between probes.
+		 */
+		int keep_alive_interval;
+
+		/**
+		 * *TCP_KEEPCNT*, number of unanswered probes to drop the connection.
+		 */
+		int keep_alive_count;
+
+		/**
+		 * *TCP_QUICKACK*, acknowledging immediately instead of delaying ACKs. Linux only.
+		 *
+		 * The kernel may fall back to delayed ACKs later; it covers the beginning of a connection.
+		 */
+		bool quick_ack;
+
+		/**
+		 * *SO_BUSY_POLL*, microseconds to busy-poll the device queue on a blocking read. Linux only.
+		 */
+		int busy_poll;
+
+		/**
+		 * Length of the queue of pending connections of a listening socket. Zero means *SOMAXCONN*.
+		 */
+		int backlog;
+
+	public:
+		/* ---------------------------------------------------------
+			CONSTRUCTORS
+		--------------------------------------------------------- */
+		/**
+		 * Default Constructor.
+		 */
+		SocketOptions()
+		{
+			no_delay = true;
+			send_buffer_size = 0;
+			receive_buffer_size = 0;
+
+			keep_alive = false;
+			keep_alive_idle = 0;
+			keep_alive_interval = 0;
+			keep_alive_count = 0;
+
+			quick_ack = false;
+			busy_poll = 0;
+			backlog = 0;
+		};
+
+		/* ---------------------------------------------------------
+			APPLIERS
+		--------------------------------------------------------- */
+		/**
+		 * Apply the options to a connected or a connecting socket.
+		 *
+		 * @param socket A TCP socket, which has been opened.
+		 */
+		void apply(boost::asio::ip::tcp::socket &socket) const
+		{
+			boost::system::error_code error;
+
+			socket.set_option(boost::asio::ip::tcp::no_delay(no_delay), error);
+			apply_buffers(socket);
+
+			if (keep_alive == true)
+			{
+				socket.set_option(boost::asio::socket_base::keep_alive(true), error);
+#if defined(TCP_KEEPIDLE) && defined(TCP_KEEPINTVL) && defined(TCP_KEEPCNT)
+				if (keep_alive_idle != 0)
+					socket.set_option(boost::asio::detail::socket_option::integer<IPPROTO_TCP, TCP_KEEPIDLE>(keep_alive_idle), error);
+				if (keep_alive_interval != 0)
+					socket.set_option(boost::asio::detail::socket_option::integer<IPPROTO_TCP, TCP_KEEPINTVL>(keep_alive_interval), error);
+				if (keep_alive_count != 0)
+					socket.set_option(boost::asio::detail::socket_option::integer<IPPROTO_TCP, TCP_KEEPCNT>(keep_alive_count), error);
+#endif
+			}
+
+#ifdef TCP_QUICKACK
+			if (quick_ack == true)
+				socket.set_option(boost::asio::detail::socket_option::boolean<IPPROTO_TCP, TCP_QUICKACK>(true), error);
+#endif
+#ifdef SO_BUSY_POLL
+			if (busy_poll != 0)
+				socket.set_option(boost::asio::detail::socket_option::integer<SOL_SOCKET, SO_BUSY_POLL>(busy_poll), error);
+#endif
+		};
+
+		/**
+		 * Apply the options to a listening socket, before binding.
+		 *
+		 * Accepted sockets inherit the buffer sizes from it.
+		 *
+		 * @param acceptor A TCP acceptor, which has been opened.
+		 */
+		void apply(boost::asio::ip::tcp::acceptor &acceptor) const
+		{
+			apply_buffers(acceptor);
+		};
+
+		/**
+		 * Get length of the queue of pending connections.
+		 */
+		auto getBacklog() const -> int
+		{
+			return (backlog == 0) ? (int)boost::asio::socket_base::max_connections : backlog;
+		};
+
+	private:
+		template <typename Socket>
+		void apply_buffers(Socket &socket) const
+		{
+			boost::system::error_code error;
+
+			if (send_buffer_size != 0)
+				socket.set_option(boost::asio::socket_base::send_buffer_size(send_buffer_size), error);
+			if (receive_buffer_size != 0)
+				socket.set_option(boost::asio::socket_base::receive_buffer_size(receive_buffer_size), error);
+		};
+	};
+};
+};
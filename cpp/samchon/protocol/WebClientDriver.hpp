@@ -56,7 +56,7 @@ namespace protocol
 		std::string path;
 
 	public:
-		WebClientDriver(std::shared_ptr<boost::asio::ip::tcp::socket> socket)
+		WebClientDriver(std::shared_ptr<Socket> socket)
 			: super(socket),
 			WebCommunicator(true)
 		{
@@ -3,9 +3,14 @@
 
 #include <samchon/protocol/Communicator.hpp>
 
+#include <algorithm>
+#include <array>
+#include <cstring>
 #include <exception>
-#include <queue>
+#include <mutex>
+#include <random>
 #include <samchon/protocol/WebSocketUtil.hpp>
+#include <samchon/protocol/PerMessageDeflate.hpp>
 
 namespace samchon
 {
@@ -26,6 +31,15 @@ namespace protocol
 	 * Note that, one of this or remote system is web-browser based, then there's not any alternative choice. Web browser
 	 * supports only Web-socket protocol. In that case, you've use a type of this {@link WebCommunicator} class.
 	 * 
+	 * If *permessage-deflate* has been negotiated on handshake, messages larger than 
+	 * {@link PerMessageDeflate.THRESHOLD} are compressed.
+	 * 
+	 * A message larger than the {@link Communicator.setMaxFrameSize maximum frame size}, after joining its fragments or
+	 * decompression, closes the connection by a close frame of the status 1009, *message too big*.
+	 * 
+	 * Besides the {@link Communicator.getMetrics metrics} of the {@link Communicator}, control frames received are
+	 * counted by ```frames.control```, and messages received compressed by ```frames.compressed```.
+	 * 
 	 * ![Basic Components](http://samchon.github.io/framework/images/design/cpp_class_diagram/protocol_basic_components.png)
 	 *
 	 * @see {@link WebClientDriver}, {@link WebServerConnector}, {@link IProtocol}
@@ -38,35 +52,86 @@ namespace protocol
 	private:
 		bool is_server;
 
+		// LARGE FRAME
+		unsigned char large_op_code;
+		bool large_fin;
+		bool large_compressed;
+		std::array<unsigned char, 4> large_mask;
+		ByteArray large_content;
+
+		// FRAGMENTED MESSAGE
+		unsigned char fragment_op_code;
+		bool fragment_compressed;
+		ByteArray fragments;
+
+		// CLOSING HANDSHAKE
+		bool closing;
+
+		// ORDER OF COMPRESSION
+		std::mutex deflate_mtx;
+
+		// METRICS
+		Metrics::Counter *control_frames;
+		Metrics::Counter *compressed_frames;
+
+	protected:
+		/**
+		 * Contexts of *permessage-deflate*, ```nullptr``` if it has not been negotiated.
+		 */
+		std::shared_ptr<PerMessageDeflate> deflate;
+
 	public:
 		WebCommunicator(bool is_server)
 			: Communicator()
 		{
 			this->is_server = is_server;
+			this->large_fin = true;
+			this->large_compressed = false;
+
+			this->fragment_op_code = 0;
+			this->fragment_compressed = false;
+			this->closing = false;
+
+			this->control_frames = &getMetrics().counter("frames.control");
+			this->compressed_frames = &getMetrics().counter("frames.compressed");
 		};
 		virtual ~WebCommunicator() = default;
 
-		virtual void sendData(std::shared_ptr<Invoke> invoke) override
+	protected:
+		virtual auto enqueue_message(std::shared_ptr<Invoke> invoke, std::function<void(const boost::system::error_code&)> callback) -> bool override
 		{
-			std::unique_lock<std::mutex> uk(send_mtx);
+			if (deflate == nullptr)
+				return Communicator::enqueue_message(invoke, callback);
 
-			// SEND INVOKE
-			const std::string &str = invoke->toXML()->toString();
-			if (is_server == true)
-				send_data(str);
-			else // CLIENT MASKS ON SENDING DATA
-				send_masked_data(str);
+			// COMPRESS IN ORDER OF THE WIRE, FOR CONTEXT TAKEOVER
+			std::unique_lock<std::mutex> uk(deflate_mtx);
+			return Communicator::enqueue_message(invoke, callback);
+		};
+
+		virtual auto is_droppable(const OutboundMessage &message) const -> bool override
+		{
+			// A DROPPED MESSAGE WOULD BREAK THE COMPRESSION CONTEXT OF THE FOLLOWINGS
+			return deflate == nullptr;
+		};
+
+		virtual auto pack_message(std::shared_ptr<Invoke> invoke) -> std::shared_ptr<OutboundMessage> override
+		{
+			std::shared_ptr<OutboundMessage> message(new OutboundMessage(invoke));
 
-			// SEND BINARY
+			// PACK INVOKE
+			if (binary_encoding == true)
+				pack_frame(*message, InvokeCodec::encode(*invoke));
+			else
+				pack_frame(*message, invoke->toXML()->toString());
+
+			// PACK BINARY
 			for (size_t i = 0; i < invoke->size(); i++)
-				if (invoke->at(i)->getType() == "ByteArray")
-					if (is_server == true)
-						send_data(invoke->at(i)->referValue<ByteArray>());
-					else // CLIENT MASKS ON SENDING DATA
-						send_masked_data(invoke->at(i)->referValue<ByteArray>());
+				if (invoke->at(i)->getTypeCode() == InvokeParameter::BYTE_ARRAY)
+					pack_frame(*message, invoke->at(i)->referValue<ByteArray>());
+
+			return message;
 		};
 
-	protected:
 		/* =========================================================
 			SOCKET I/O
 				- READ
@@ -74,259 +139,415 @@ namespace protocol
 		============================================================
 			READ
 		--------------------------------------------------------- */
-		virtual void listen_message() override
+		virtual auto handle_buffered_frames(size_t &remainder) -> bool override
 		{
-			std::shared_ptr<Invoke> binary_invoke = nullptr;
-			std::queue<std::shared_ptr<InvokeParameter>> binary_parameters;
+			remainder = 0;
 
-			while (true)
+			while (receive_buffer.size() >= 2)
 			{
-				try
+				// FRAMES AFTER CLOSING ARE DISCARDED, WITHOUT PARSING
+				if (closing == true)
 				{
-					const std::pair<unsigned char, size_t> &header = listen_header();
-
-					// EXIT CODE
-					if (header.first == WebSocketUtil::DISCONNECT)
-						break;
-
-					// READ DATA
-					if (header.first == WebSocketUtil::TEXT)
-					{
-						std::shared_ptr<Invoke> invoke = listen_string(header.second);
-
-						for (size_t i = 0; i < invoke->size(); i++)
-						{
-							std::shared_ptr<InvokeParameter> &parameter = invoke->at(i);
-							if (parameter->getType() != "ByteArray")
-								continue;
-
-							if (binary_invoke == nullptr)
-								binary_invoke = invoke;
-							binary_parameters.push(parameter);
-						}
-
-						// NO BINARY, THEN REPLY DIRECTLY
-						if (binary_invoke == nullptr)
-							this->replyData(invoke);
-					}
-					else if (header.first == WebSocketUtil::BINARY)
-					{
-						std::shared_ptr<InvokeParameter> parameter = binary_parameters.front();
-						listen_binary(header.second, parameter);
-						binary_parameters.pop();
-
-						if (binary_parameters.empty() == true)
-						{
-							// NO BINARY PARAMETER LEFT,
-							std::shared_ptr<Invoke> invoke = binary_invoke;
-							binary_invoke = nullptr;
-
-							// THEN REPLY
-							this->replyData(invoke);
-						}
-					}
+					receive_buffer.consume(receive_buffer.size());
+					break;
 				}
-				catch (...)
+
+				const unsigned char *header = receive_buffer.data();
+				unsigned char op_code = WebSocketUtil::FIN | (header[0] & 15);
+				bool fin = (header[0] & WebSocketUtil::FIN) != 0;
+				bool compressed = (header[0] & WebSocketUtil::RSV1) != 0;
+				unsigned char size_code = header[1];
+
+				// INSPECT MASK VALIDATION
+				if (is_server == true && size_code < WebSocketUtil::MASK)
+					throw std::domain_error("unmasked message from client has delivered.");
+				else if (is_server == false && size_code >= WebSocketUtil::MASK)
+					throw std::domain_error("masked message from server has delivered.");
+
+				// INSPECT RESERVED BITS
+				if ((header[0] & (WebSocketUtil::RSV2 | WebSocketUtil::RSV3)) != 0)
+					throw std::domain_error("reserved bits of a frame have been set.");
+				else if (compressed == true && (deflate == nullptr || op_code == WebSocketUtil::CONTINUATION || op_code >= WebSocketUtil::DISCONNECT))
+					throw std::domain_error("compressed message without permessage-deflate has delivered.");
+
+				// SIZE BYTES AND MASK
+				size_code &= ~WebSocketUtil::MASK;
+
+				size_t size_bytes = 0;
+				if (size_code == (unsigned char)WebSocketUtil::TWO_BYTES)
+					size_bytes = 2;
+				else if (size_code == (unsigned char)WebSocketUtil::EIGHT_BYTES)
+					size_bytes = 8;
+
+				size_t header_size = 2 + size_bytes + (is_server ? 4 : 0); // CLIENT SENDS MASKED DATA
+				if (receive_buffer.size() < header_size)
+					break;
+
+				unsigned long long content_size = (size_bytes == 0) ? size_code : 0;
+				for (size_t c = 0; c < size_bytes; c++)
+					content_size = (content_size << 8) | header[2 + c];
+
+				// INSPECT SIZE
+				if (content_size >> 63 != 0)
+					throw std::domain_error("size of a frame is out of range.");
+				else if (op_code >= WebSocketUtil::DISCONNECT && (fin == false || content_size > 125))
+					throw std::domain_error("a control frame is fragmented or too large.");
+				else if (op_code < WebSocketUtil::DISCONNECT 
+					&& content_size + (op_code == WebSocketUtil::CONTINUATION ? fragments.size() : 0) > max_frame_size)
+				{
+					// BEFORE ALLOCATING
+					close_by(WebSocketUtil::MESSAGE_TOO_BIG);
+					continue;
+				}
+
+				std::array<unsigned char, 4> mask;
+				if (is_server == true)
+					std::copy(header + 2 + size_bytes, header + header_size, mask.begin());
+
+				// READ DATA
+				size_t buffered = receive_buffer.size() - header_size;
+
+				if (buffered >= content_size)
 				{
+					// COMPLETE FRAME, UNMASKED AND HANDLED IN PLACE
+					receive_buffer.consume(header_size);
+					unsigned char *data = receive_buffer.data();
+
+					if (is_server == true)
+						WebSocketUtil::mask(data, (size_t)content_size, mask.data());
+
+					if (closing == false)
+						handle_web_frame(op_code, fin, compressed, data, (size_t)content_size);
+					receive_buffer.consume((size_t)content_size);
+				}
+				else if (header_size + content_size <= receive_buffer.capacity())
+					break; // WAIT FOR THE REST
+				else
+				{
+					// LARGE FRAME, READ DIRECTLY INTO ITS OWN BUFFER
+					receive_buffer.consume(header_size);
+					large_op_code = op_code;
+					large_fin = fin;
+					large_compressed = compressed;
+					large_mask = mask;
+
+					large_content.clear();
+					large_content.resizeUninitialized((size_t)content_size);
+					large_frame = large_content.data();
+
+					std::memcpy(large_frame, receive_buffer.data(), buffered);
+					receive_buffer.consume(buffered);
+
+					large_frame += buffered;
+					remainder = (size_t)content_size - buffered;
 					break;
 				}
 			}
+			return true;
 		};
 
-	private:
-		auto listen_header() -> std::pair<unsigned char, size_t>
+		virtual void handle_large_frame() override
 		{
-			unsigned char mask = is_server ? WebSocketUtil::MASK : 0;
-
-			std::array<unsigned char, 2> header_bytes;
-			unsigned char op_code; // false then binary
-			unsigned char size_header;
-
-			size_t content_size = 0;
+			ByteArray frame;
+			frame.swap(large_content);
 
-			// READ HEADER BYTES
-			listen_data(header_bytes);
-			op_code = header_bytes[0];
-			size_header = header_bytes[1];
-
-			// INSPECT MASK VALIDATION
 			if (is_server == true)
+				WebSocketUtil::mask(frame.data(), frame.size(), large_mask.data());
+
+			if (closing == true)
+				return;
+			else if (large_op_code == WebSocketUtil::CONTINUATION)
 			{
-				if (size_header < WebSocketUtil::MASK)
-					throw std::domain_error("masked message from server has delivered.");
+				if (fragment_op_code == 0)
+					throw std::domain_error("continuation frame without a fragmented message has delivered.");
+				else if (fragments.empty() == true)
+					fragments = std::move(frame);
+				else
+					fragments.insert(fragments.end(), frame.begin(), frame.end());
+
+				if (large_fin == true)
+					handle_fragments();
 			}
-			else
+			else if (large_op_code == WebSocketUtil::TEXT || large_op_code == WebSocketUtil::BINARY)
 			{
-				if (size_header >= WebSocketUtil::MASK)
-					throw std::domain_error("masked message from server has delivered.");
+				if (fragment_op_code != 0)
+					throw std::domain_error("a new message has delivered before end of the fragmented message.");
+				else if (large_fin == false)
+				{
+					fragment_op_code = large_op_code;
+					fragment_compressed = large_compressed;
+					fragments = std::move(frame);
+				}
+				else if (large_compressed == true)
+					handle_compressed(frame.data(), frame.size());
+				else
+					handle_frame(std::move(frame));
 			}
+			else
+				throw std::domain_error("unknown op code of a frame has delivered.");
+		};
 
-			// EXIT CODE
-			if (op_code == WebSocketUtil::DISCONNECT)
-				return{ op_code, 0 }; // DISCONNECTION SIGNAL HAS ARRIVED
-
-									  // READ CONTENT SIZE
-			if (is_server)
-				size_header -= WebSocketUtil::MASK; // CLIENT SENDS MASKED DATA, DETACH THE MASK
+	private:
+		/**
+		 * Handle a complete frame, unmasked.
+		 * 
+		 * Content of a TEXT or BINARY message, after joining its fragments and decompression, is 
+		 * {@link Communicator.handle_frame handled} as an {@link Invoke} message or content of a *ByteArray* parameter, by 
+		 * the state. Control frames may arrive between fragments of a message.
+		 */
+		void handle_web_frame(unsigned char op_code, bool fin, bool compressed, const unsigned char *data, size_t size)
+		{
+			if (op_code >= WebSocketUtil::DISCONNECT)
+				control_frames->fetch_add(1, std::memory_order_relaxed);
 
-			if (size_header == (unsigned char)WebSocketUtil::TWO_BYTES)
+			switch (op_code)
 			{
-				// SIZE HEADER IS 2 BYTES
-				std::array<unsigned char, 2> size_bytes;
-				listen_data(size_bytes);
+			case WebSocketUtil::CONTINUATION:
+				if (fragment_op_code == 0)
+					throw std::domain_error("continuation frame without a fragmented message has delivered.");
+
+				fragments.insert(fragments.end(), data, data + size);
+				if (fin == true)
+					handle_fragments();
+				break;
+
+			case WebSocketUtil::TEXT:
+			case WebSocketUtil::BINARY:
+				if (fragment_op_code != 0)
+					throw std::domain_error("a new message has delivered before end of the fragmented message.");
+				else if (fin == false)
+				{
+					fragment_op_code = op_code;
+					fragment_compressed = compressed;
+					fragments.assign(data, data + size);
+				}
+				else if (compressed == true)
+					handle_compressed(data, size);
+				else
+					handle_frame(data, size);
+				break;
 
-				for (size_t c = 0; c < size_bytes.size(); c++)
-					content_size += size_bytes[c] << (8 * (size_bytes.size() - 1 - c));
-			}
-			else if (size_header == (unsigned char)WebSocketUtil::EIGHT_BYTES)
-			{
-				// SIZE HEADER IS 8 BYTES
-				std::array<unsigned char, 8> size_bytes;
-				listen_data(size_bytes);
+			case WebSocketUtil::PING:
+				send_control(WebSocketUtil::PONG, data, size);
+				break;
 
-				for (size_t c = 0; c < size_bytes.size(); c++)
-					content_size += size_bytes[c] << (8 * (size_bytes.size() - 1 - c));
-			}
-			else
-				content_size = (size_t)size_header;
+			case WebSocketUtil::PONG:
+				break;
+
+			case WebSocketUtil::DISCONNECT:
+				handle_disconnect(data, size);
+				break;
 
-			return{ op_code, content_size };
+			default:
+				throw std::domain_error("unknown op code of a frame has delivered.");
+			}
 		};
 
-		auto listen_string(size_t size) -> std::shared_ptr<Invoke>
+		void handle_fragments()
 		{
-			// READ CONTENT
-			std::string data(size, (char)NULL);
-			if (is_server) // CLIENT SENDS MASKED DATA
-				listen_masked_data(data);
+			ByteArray message;
+			message.swap(fragments);
+
+			bool compressed = fragment_compressed;
+			fragment_op_code = 0;
+			fragment_compressed = false;
+
+			if (compressed == true)
+				handle_compressed(message.data(), message.size());
 			else
-				listen_data(data);
+				handle_frame(std::move(message));
+		};
 
-			// CONSTRUCT INVOKE OBJECT
-			std::shared_ptr<Invoke> invoke(new Invoke());
-			invoke->construct(std::make_shared<library::XML>(data));
+		void handle_compressed(const unsigned char *data, size_t size)
+		{
+			compressed_frames->fetch_add(1, std::memory_order_relaxed);
 
-			return invoke;
+			ByteArray message;
+			try
+			{
+				message = deflate->decompress(data, size, max_frame_size);
+			}
+			catch (const std::length_error &)
+			{
+				close_by(WebSocketUtil::MESSAGE_TOO_BIG);
+				return;
+			}
+			handle_frame(std::move(message));
 		};
 
-		void listen_binary(size_t size, std::shared_ptr<InvokeParameter> parameter)
+		/**
+		 * Handle a close frame from the remote system.
+		 * 
+		 * Replies a close frame with the same status code, then closes the socket after the reply has been written. 
+		 * Frames after the close frame are ignored, and listening ends by the disconnection.
+		 */
+		void handle_disconnect(const unsigned char *data, size_t size)
 		{
-			// FETCH BYTE_ARRAY
-			ByteArray &data = (ByteArray&)parameter->referValue<ByteArray>();
+			closing = true;
 
-			// READ CONTENT
-			if (is_server == true) // CLIENT SENDS MASKED DATA
-				listen_masked_data(data);
-			else
-				listen_data(data);
+			std::shared_ptr<OutboundMessage> message = pack_control(WebSocketUtil::DISCONNECT, data, std::min<size_t>(size, 2));
+			message->setCallback([this](const boost::system::error_code &)
+			{
+				close();
+			});
+			send_message(message);
 		};
 
-		template <class Container>
-		void listen_data(Container &data)
+		/**
+		 * Close the connection by a close frame of the *status* code.
+		 * 
+		 * The socket is closed after the close frame has been written. Frames arriving meanwhile are discarded.
+		 */
+		void close_by(unsigned short status)
 		{
-			size_t completed = 0;
+			closing = true;
+			fragment_op_code = 0;
+			fragments.clear();
 
-			if (completed < data.size())
-				completed += socket->read_some(boost::asio::buffer((unsigned char*)data.data() + completed, data.size() - completed));
+			unsigned char data[2] = { (unsigned char)(status >> 8), (unsigned char)(status & 0xFF) };
+
+			std::shared_ptr<OutboundMessage> message = pack_control(WebSocketUtil::DISCONNECT, data, 2);
+			message->setCallback([this](const boost::system::error_code &)
+			{
+				close();
+			});
+			send_message(message);
 		};
 
-		template <class Container>
-		void listen_masked_data(Container &data)
+		void send_control(unsigned char op_code, const unsigned char *data, size_t size)
 		{
-			// READ MASK
-			std::array<unsigned char, 4> mask;
-			socket->read_some(boost::asio::buffer(mask));
+			send_message(pack_control(op_code, data, size));
+		};
+
+		auto pack_control(unsigned char op_code, const unsigned char *data, size_t size) -> std::shared_ptr<OutboundMessage>
+		{
+			ByteArray payload;
+			payload.assign(data, data + size);
 
-			// READ DATA
-			listen_data(data);
+			std::shared_ptr<OutboundMessage> message(new OutboundMessage());
+			pack_owned_frame(*message, op_code, payload);
+			message->push(std::move(payload));
 
-			// UNMASK
-			for (size_t i = 0; i < data.size(); i++)
-				data[i] = data[i] ^ mask[i % 4];
+			return message;
 		};
 
 		/* ---------------------------------------------------------
 			WRITE
 		--------------------------------------------------------- */
-		template <class Container>
-		void send_data(const Container &data)
+		void pack_frame(OutboundMessage &message, std::string &&data)
 		{
-			unsigned char op_code = std::is_same<std::string, Container>()
-				? WebSocketUtil::TEXT
-				: WebSocketUtil::BINARY;
-			size_t size = data.size();
-
-			///////
-			// SEND HEADER
-			///////
-			ByteArray header;
-			header.write(op_code);
+			if (deflate != nullptr && data.size() >= PerMessageDeflate::THRESHOLD)
+				pack_compressed_frame(message, WebSocketUtil::TEXT, (const unsigned char*)data.data(), data.size());
+			else
+			{
+				pack_owned_frame(message, WebSocketUtil::TEXT, data);
+				message.push(std::move(data));
+			}
+		};
 
-			if (size < 126)
-				header.write((unsigned char)size);
-			else if (size < 0xFFFF)
+		void pack_frame(OutboundMessage &message, ByteArray &&data)
+		{
+			if (deflate != nullptr && data.size() >= PerMessageDeflate::THRESHOLD)
+				pack_compressed_frame(message, WebSocketUtil::BINARY, data.data(), data.size());
+			else
 			{
-				header.write((unsigned char)(WebSocketUtil::TWO_BYTES));
-				header.writeReversely((unsigned short)size);
+				pack_owned_frame(message, WebSocketUtil::BINARY, data);
+				message.push(std::move(data));
+			}
+		};
+
+		void pack_frame(OutboundMessage &message, const ByteArray &data)
+		{
+			if (deflate != nullptr && data.size() >= PerMessageDeflate::THRESHOLD)
+				pack_compressed_frame(message, WebSocketUtil::BINARY, data.data(), data.size());
+			else if (is_server == true)
+			{
+				message.push(frame_header(WebSocketUtil::BINARY, data.size(), nullptr));
+				message.refer(data.data(), data.size());
 			}
 			else
 			{
-				header.write((unsigned char)(WebSocketUtil::EIGHT_BYTES));
-				header.writeReversely((unsigned long long)size);
+				// CLIENT MASKS ON SENDING DATA, STRAIGHT INTO A BUFFER OF THE MESSAGE
+				std::array<unsigned char, 4> mask = generate_mask();
+
+				ByteArray masked;
+				masked.resizeUninitialized(data.size());
+				WebSocketUtil::mask(data.data(), masked.data(), data.size(), mask.data());
+
+				message.push(frame_header(WebSocketUtil::BINARY, data.size(), mask.data()));
+				message.push(std::move(masked));
 			}
+		};
+
+		/**
+		 * Pack a frame compressed by *permessage-deflate*, marked by the RSV1 bit.
+		 */
+		void pack_compressed_frame(OutboundMessage &message, unsigned char op_code, const unsigned char *data, size_t size)
+		{
+			ByteArray compressed = deflate->compress(data, size);
 
-			socket->write_some(boost::asio::buffer(header)); // SEND HEADER
-			socket->write_some(boost::asio::buffer(data)); // SEND DATA
+			pack_owned_frame(message, op_code | WebSocketUtil::RSV1, compressed);
+			message.push(std::move(compressed));
 		};
 
+		/**
+		 * Pack header of a frame whose content is owned by the message, thus can be masked in place.
+		 */
 		template <class Container>
-		void send_masked_data(const Container &data)
+		void pack_owned_frame(OutboundMessage &message, unsigned char op_code, Container &data)
 		{
-			unsigned char op_code = std::is_same<std::string, Container>()
-				? WebSocketUtil::TEXT
-				: WebSocketUtil::BINARY;
-			size_t size = data.size();
-
-			///////
-			// SEND HEADER
-			///////
+			if (is_server == true)
+			{
+				message.push(frame_header(op_code, data.size(), nullptr));
+				return;
+			}
+
+			// CLIENT MASKS ON SENDING DATA, IN PLACE
+			std::array<unsigned char, 4> mask = generate_mask();
+
+			message.push(frame_header(op_code, data.size(), mask.data()));
+			WebSocketUtil::mask((unsigned char*)&data[0], data.size(), mask.data());
+		};
+
+		static auto generate_mask() -> std::array<unsigned char, 4>
+		{
+			// FRAMES ARE PACKED BY ANY SENDING THREAD, THUS AN ENGINE PER THREAD
+			thread_local std::mt19937 engine(std::random_device{}());
+
+			// A DRAW FOR THE 4 BYTES
+			unsigned int key = (unsigned int)engine();
+
+			std::array<unsigned char, 4> mask;
+			std::memcpy(mask.data(), &key, mask.size());
+
+			return mask;
+		};
+
+		static auto frame_header(unsigned char op_code, size_t size, const unsigned char *mask) -> ByteArray
+		{
+			unsigned char mask_flag = (mask == nullptr) ? 0 : WebSocketUtil::MASK;
+
 			ByteArray header;
 			header.write(op_code);
 
 			if (size < 126)
-				header.write((unsigned char)(size + WebSocketUtil::MASK));
-			else if (size < 0xFFFF)
+				header.write((unsigned char)(size + mask_flag));
+			else if (size <= 0xFFFF)
 			{
-				header.write((unsigned char)(WebSocketUtil::TWO_BYTES + WebSocketUtil::MASK));
+				header.write((unsigned char)(WebSocketUtil::TWO_BYTES + mask_flag));
 				header.writeReversely((unsigned short)size);
 			}
 			else
 			{
-				header.write((unsigned char)(WebSocketUtil::EIGHT_BYTES + WebSocketUtil::MASK));
+				header.write((unsigned char)(WebSocketUtil::EIGHT_BYTES + mask_flag));
 				header.writeReversely((unsigned long long)size);
 			}
 
-			///////
-			// SEND DATA
-			///////
-			static std::uniform_int_distribution<unsigned short> distribution(0, 255);
-			static std::random_device device;
+			if (mask != nullptr)
+				header.insert(header.end(), mask, mask + 4);
 
-			// CONSTRUCT MASK
-			std::array<unsigned char, 4> mask;
-			for (size_t i = 0; i < mask.size(); i++)
-				mask[i] = (unsigned char)distribution(device);
-
-			// TO BE MASKED
-			std::vector<unsigned char> masked_data(data.size());
-			for (size_t i = 0; i < masked_data.size(); i++)
-				masked_data[i] = data[i] ^ mask[i % 4];
-
-			// SEND
-			socket->write_some(boost::asio::buffer(header)); // SEND HEADER
-			socket->write_some(boost::asio::buffer(mask)); // SEND MASK
-			socket->write_some(boost::asio::buffer(masked_data)); // SEND MASKED DATA
+			return header;
 		};
 	};
 };
-};
\ No newline at end of file
+};
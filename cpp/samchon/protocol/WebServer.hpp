@@ -9,6 +9,7 @@
 #include <samchon/WeakString.hpp>
 #include <samchon/library/StringUtil.hpp>
 #include <samchon/protocol/WebSocketUtil.hpp>
+#include <samchon/protocol/PerMessageDeflate.hpp>
 
 namespace samchon
 {
@@ -55,6 +56,9 @@ namespace protocol
 
 		size_t sequence;
 
+		bool per_message_deflate;
+		bool context_takeover;
+
 	public:
 		/**
 		 * Default Constructor.
@@ -63,24 +67,59 @@ namespace protocol
 			: super()
 		{
 			sequence = 0;
+
+			per_message_deflate = false;
+			context_takeover = true;
 		};
 		virtual ~WebServer() = default;
 
-	private:
-		virtual void handle_connection(std::shared_ptr<boost::asio::ip::tcp::socket> socket) override
+		/**
+		 * Accept *permessage-deflate*.
+		 * 
+		 * Configures whether to accept the *permessage-deflate* extension when a client offers it on handshake. Then 
+		 * messages larger than {@link PerMessageDeflate.THRESHOLD} are compressed in both directions. Browsers offer it
+		 * by default. It must be called before {@link open opening} the server.
+		 * 
+		 * @param flag Whether to accept *permessage-deflate*. Default is ```false```.
+		 * @param context_takeover Whether to keep compression contexts across messages. It makes similar messages much
+		 *						   smaller, at cost of memory for each connection.
+		 */
+		void setPerMessageDeflate(bool flag, bool context_takeover = true)
 		{
-			std::array<char, 1000> byte_array;
-			boost::system::error_code error;
+			this->per_message_deflate = flag;
+			this->context_takeover = context_takeover;
+		};
 
+	private:
+		virtual void handle_connection(std::shared_ptr<Socket> socket) override
+		{
 			///////
 			// LISTEN HEADER
 			///////
-			size_t size = socket->read_some(boost::asio::buffer(byte_array), error);
-			if (error)
-				return;
+			std::shared_ptr<std::array<char, 1000>> byte_array(new std::array<char, 1000>());
 
-			// HEADER FROM CLIENT
-			WeakString header(byte_array.data(), size);
+			if (service_pool != nullptr)
+			{
+				// ASYNCHRONOUS MODE DOES NOT HOLD A THREAD WHILE WAITING THE HANDSHAKE
+				socket->async_read_some(boost::asio::buffer(*byte_array), [this, socket, byte_array](const boost::system::error_code &error, size_t size)
+				{
+					if (!error)
+						handle_handshake(socket, WeakString(byte_array->data(), size));
+				});
+			}
+			else
+			{
+				boost::system::error_code error;
+				size_t size = socket->read_some(boost::asio::buffer(*byte_array), error);
+
+				if (!error)
+					handle_handshake(socket, WeakString(byte_array->data(), size));
+			}
+		};
+
+		void handle_handshake(std::shared_ptr<Socket> socket, WeakString header)
+		{
+			boost::system::error_code error;
 
 			// KEY VALUES
 			WeakString path = header.between("", "\r\n").between(" /", " HTTP");
@@ -95,6 +134,20 @@ namespace protocol
 			if (encrypted_cert_key.find("\r") != std::string::npos)
 				encrypted_cert_key = encrypted_cert_key.between("", "\r");
 
+			// SUB-PROTOCOL, BINARY ENCODING OF INVOKE
+			bool binary_encoding = header.find("Sec-WebSocket-Protocol:") != std::string::npos
+				&& header.between("Sec-WebSocket-Protocol:", "\n").find(WebSocketUtil::BINARY_SUB_PROTOCOL()) != std::string::npos;
+
+			// EXTENSION, PERMESSAGE-DEFLATE
+			std::shared_ptr<PerMessageDeflate> deflate;
+			std::string extension;
+
+			if (per_message_deflate == true && header.find("Sec-WebSocket-Extensions:") != std::string::npos)
+			{
+				std::string offers = header.between("Sec-WebSocket-Extensions:", "\n").trim().str();
+				deflate = PerMessageDeflate::accept(offers, context_takeover, extension);
+			}
+
 			if (header.find("Set-Cookie: ") != std::string::npos)
 			{
 				cookie = header.between("Set-Cookie: ", "\r\n");
@@ -139,10 +192,14 @@ namespace protocol
 				"Connection: Upgrade\r\n" +
 				"Set-Cookie: {1}\r\n" +
 				"Sec-WebSocket-Accept: {2}\r\n" +
+				"{3}" + // sub-protocol
+				"{4}" + // extension
 				"\r\n",
 
 				cookie,
-				WebSocketUtil::encode_certification_key(encrypted_cert_key)
+				WebSocketUtil::encode_certification_key(encrypted_cert_key),
+				binary_encoding ? "Sec-WebSocket-Protocol: " + WebSocketUtil::BINARY_SUB_PROTOCOL() + "\r\n" : "",
+				deflate != nullptr ? "Sec-WebSocket-Extensions: " + extension + "\r\n" : ""
 			);
 
 			// SEND
@@ -157,6 +214,10 @@ namespace protocol
 			std::shared_ptr<WebClientDriver> driver(new WebClientDriver(socket));
 			driver->session_id = session_id;
 			driver->path = path.str();
+			driver->binary_encoding = binary_encoding;
+			driver->deflate = deflate;
+			if (service_pool != nullptr)
+				driver->set_service_pool(service_pool);
 
 			// ADD CLIENT
 			addClient(driver);
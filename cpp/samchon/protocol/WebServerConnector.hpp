@@ -51,14 +51,36 @@ namespace protocol
 		static std::map<std::pair<std::string, int>, std::string> s_cookies;
 		static std::shared_mutex s_mtx;
 
+		bool prefer_per_message_deflate;
+		bool context_takeover;
+
 	public:
 		WebServerConnector(IProtocol *listener)
 			: super(listener),
 			WebCommunicator(false)
 		{
+			prefer_per_message_deflate = false;
+			context_takeover = true;
 		};
 		virtual ~WebServerConnector() = default;
 
+		/**
+		 * Prefer *permessage-deflate*.
+		 * 
+		 * Configures whether to offer the *permessage-deflate* extension to the server on {@link connect connection}.
+		 * When the server accepts the offer, messages larger than {@link PerMessageDeflate.THRESHOLD} are compressed in 
+		 * both directions. A server who doesn't know the extension ignores the offer.
+		 * 
+		 * @param flag Whether to offer *permessage-deflate*. Default is ```false```.
+		 * @param context_takeover Whether to keep compression contexts across messages. It makes similar messages much
+		 *						   smaller, at cost of memory for each connection.
+		 */
+		void setPerMessageDeflate(bool flag, bool context_takeover = true)
+		{
+			this->prefer_per_message_deflate = flag;
+			this->context_takeover = context_takeover;
+		};
+
 		/**
 		 * Connect to a web server.
 		 * 
@@ -109,7 +131,7 @@ namespace protocol
 
 			handshake(ip, port, path);
 
-			listen_message();
+			start_listening();
 		};
 
 	private:
@@ -143,12 +165,16 @@ namespace protocol
 				"{3}" + // cookie
 				"Sec-WebSocket-Key: {4}\r\n" + // hashed certification key
 				"Sec-WebSocket-Version: 13\r\n" +
+				"{5}" + // sub-protocol
+				"{6}" + // extension
 				"\r\n",
 
 				path.empty() ? "/" : "/" + path,
 				ip + ":" + std::to_string(port),
 				cookie,
-				base64_key
+				base64_key,
+				prefer_binary_encoding ? "Sec-WebSocket-Protocol: " + WebSocketUtil::BINARY_SUB_PROTOCOL() + "\r\n" : "",
+				prefer_per_message_deflate ? "Sec-WebSocket-Extensions: " + PerMessageDeflate::offer(context_takeover) + "\r\n" : ""
 			);
 			socket->write_some(boost::asio::buffer(query.data(), query.size()));
 
@@ -165,6 +191,27 @@ namespace protocol
 			if (sha1_key != server_sha1)
 				throw std::domain_error("WebSocket handshaking has failed.");
 
+			// BYTES FOLLOWING THE HEADER ARE THE FIRST FRAMES
+			size_t header_size = wstr.find("\r\n\r\n") + 4;
+			if (header_size != WeakString::npos + 4 && header_size < size)
+			{
+				boost::asio::mutable_buffer space = receive_buffer.prepare();
+				std::memcpy(space.data(), byte_array.data() + header_size, size - header_size);
+
+				receive_buffer.commit(size - header_size);
+			}
+
+			// BINARY ENCODING, IF THE SERVER HAS ACCEPTED THE SUB-PROTOCOL. XML OTHERWISE
+			binary_encoding = prefer_binary_encoding == true
+				&& wstr.find("Sec-WebSocket-Protocol: ") != std::string::npos
+				&& wstr.between("Sec-WebSocket-Protocol: ", "\r\n").str() == WebSocketUtil::BINARY_SUB_PROTOCOL();
+
+			// PERMESSAGE-DEFLATE, IF THE SERVER HAS ACCEPTED THE EXTENSION
+			if (prefer_per_message_deflate == true && wstr.find("Sec-WebSocket-Extensions: ") != std::string::npos)
+				deflate = PerMessageDeflate::construct(wstr.between("Sec-WebSocket-Extensions: ", "\r\n").str(), context_takeover);
+			else
+				deflate = nullptr;
+
 			// SET-COOKIE
 			if (wstr.find("Set-Cookie: ") != std::string::npos)
 			{
@@ -3,8 +3,22 @@
 
 #include <string>
 #include <random>
+#include <cstdint>
+#include <cstring>
 #include <boost/uuid/sha1.hpp>
 
+#if defined(__x86_64__) || defined(_M_X64)
+#	include <immintrin.h>
+#	if defined(_MSC_VER)
+#		include <intrin.h>
+#		define SAMCHON_TARGET_AVX2
+#	else
+#		define SAMCHON_TARGET_AVX2 __attribute__((target("avx2")))
+#	endif
+#elif defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#	include <emmintrin.h>
+#endif
+
 #include <samchon/ByteArray.hpp>
 #include <samchon/library/Base64.hpp>
 #include <samchon/library/Date.hpp>
@@ -16,11 +30,17 @@ namespace protocol
 	class WebSocketUtil
 	{
 	public:
+		/**
+		 * Op codes, with the FIN bit.
+		 */
 		enum OpCode : unsigned char
 		{
+			CONTINUATION = 128,
 			TEXT = 129,
 			BINARY = 130,
-			DISCONNECT = 136
+			DISCONNECT = 136,
+			PING = 137,
+			PONG = 138
 		};
 
 		enum SizeCode : unsigned char
@@ -29,12 +49,44 @@ namespace protocol
 			EIGHT_BYTES = 127
 		};
 
+		/**
+		 * Status codes of a close frame.
+		 */
+		enum StatusCode : unsigned short
+		{
+			MESSAGE_TOO_BIG = 1009
+		};
+
 		static const unsigned char MASK = 128;
 
+		/**
+		 * FIN bit of the first byte, marking the last frame of a message.
+		 */
+		static const unsigned char FIN = 128;
+
+		/**
+		 * RSV1 bit of the first byte, marking a message compressed by {@link PerMessageDeflate}.
+		 */
+		static const unsigned char RSV1 = 64;
+
+		/**
+		 * RSV2 and RSV3 bits of the first byte, which no extension uses.
+		 */
+		static const unsigned char RSV2 = 32;
+		static const unsigned char RSV3 = 16;
+
 		static auto GUID() -> std::string
 		{
 			return "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
 		};
+
+		/**
+		 * Sub-protocol name of the {@link InvokeCodec binary encoding}, negotiated on handshake.
+		 */
+		static auto BINARY_SUB_PROTOCOL() -> std::string
+		{
+			return "samchon-binary";
+		};
 		
 		static auto generate_base64_certification_key() -> std::string
 		{
@@ -67,6 +119,124 @@ namespace protocol
 
 			return library::Base64::encode(bytes);
 		};
+
+		/* ---------------------------------------------------------
+			MASKING
+		--------------------------------------------------------- */
+		/**
+		 * Mask or unmask a payload in place.
+		 * 
+		 * @param data Address of the payload.
+		 * @param size Size of the payload.
+		 * @param mask The 4 bytes masking key.
+		 */
+		static void mask(unsigned char *data, size_t size, const unsigned char *mask)
+		{
+			WebSocketUtil::mask(data, data, size, mask);
+		};
+
+		/**
+		 * Mask or unmask a payload, into another buffer.
+		 * 
+		 * XORs 32 bytes at once with AVX2, or 16 bytes with SSE2. On x64, AVX2 is chosen at runtime by the CPU, so 
+		 * no ```/arch``` or ```-m``` flag is required; SSE2 is always there. On 32 bits x86, SSE2 is used when the 
+		 * code is built for it. Otherwise, or for the tail, 8 bytes and then a byte at once.
+		 * 
+		 * @param source Address of the payload.
+		 * @param destination Address to write the masked payload, which can be the *source*.
+		 * @param size Size of the payload.
+		 * @param mask The 4 bytes masking key.
+		 */
+		static void mask(const unsigned char *source, unsigned char *destination, size_t size, const unsigned char *mask)
+		{
+			uint32_t key;
+			std::memcpy(&key, mask, 4);
+
+			size_t i = 0;
+
+#if defined(__x86_64__) || defined(_M_X64)
+			if (has_avx2() == true)
+				i = mask_avx2(source, destination, size, key);
+			else
+				i = mask_sse2(source, destination, size, key);
+#elif defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+			i = mask_sse2(source, destination, size, key);
+#endif
+			// SCALAR, 8 BYTES AT ONCE
+			uint64_t key64 = ((uint64_t)key << 32) | key;
+			for (; i + 8 <= size; i += 8)
+			{
+				uint64_t block;
+				std::memcpy(&block, source + i, 8);
+				block ^= key64;
+				std::memcpy(destination + i, &block, 8);
+			}
+
+			// TAIL, AT AN OFFSET OF MULTIPLE OF 4
+			for (; i < size; i++)
+				destination[i] = source[i] ^ mask[i % 4];
+		};
+
+	private:
+#if defined(__x86_64__) || defined(_M_X64)
+		// DETECTED ONCE, THE CPU AND THE OPERATING SYSTEM SAVING THE AVX REGISTERS
+		static auto has_avx2() -> bool
+		{
+			static const bool supported = detect_avx2();
+			return supported;
+		};
+
+		static auto detect_avx2() -> bool
+		{
+#if defined(_MSC_VER)
+			int info[4];
+			__cpuid(info, 0);
+			if (info[0] < 7)
+				return false;
+
+			__cpuid(info, 1);
+			if ((info[2] & (1 << 27)) == 0 || (info[2] & (1 << 28)) == 0) // OSXSAVE, AVX
+				return false;
+			if ((_xgetbv(0) & 6) != 6) // XMM AND YMM STATES
+				return false;
+
+			__cpuidex(info, 7, 0);
+			return (info[1] & (1 << 5)) != 0; // AVX2
+#else
+			__builtin_cpu_init();
+			return __builtin_cpu_supports("avx2") != 0;
+#endif
+		};
+
+		SAMCHON_TARGET_AVX2
+		static auto mask_avx2(const unsigned char *source, unsigned char *destination, size_t size, uint32_t key) -> size_t
+		{
+			__m256i key256 = _mm256_set1_epi32((int)key);
+
+			size_t i = 0;
+			for (; i + 32 <= size; i += 32)
+			{
+				__m256i block = _mm256_loadu_si256((const __m256i*)(source + i));
+				_mm256_storeu_si256((__m256i*)(destination + i), _mm256_xor_si256(block, key256));
+			}
+			return i;
+		};
+#endif
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+		static auto mask_sse2(const unsigned char *source, unsigned char *destination, size_t size, uint32_t key) -> size_t
+		{
+			__m128i key128 = _mm_set1_epi32((int)key);
+
+			size_t i = 0;
+			for (; i + 16 <= size; i += 16)
+			{
+				__m128i block = _mm_loadu_si128((const __m128i*)(source + i));
+				_mm_storeu_si128((__m128i*)(destination + i), _mm_xor_si128(block, key128));
+			}
+			return i;
+		};
+#endif
 	};
 };
 };
\ No newline at end of file
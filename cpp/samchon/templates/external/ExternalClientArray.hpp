@@ -74,16 +74,21 @@ namespace external
 				library::UniqueWriteLock uk(getMutex());
 				push_back(system);
 			}
-			driver->listen(system.get());
 
-			for (size_t i = 0; i < size(); i++)
-				if (at(i) == system)
-				{
-					library::UniqueWriteLock uk(getMutex());
+			// AFTER DISCONNECTION, ERASE THE SYSTEM
+			ExternalSystem *raw_system = system.get();
+			driver->onClose = [this, raw_system]()
+			{
+				library::UniqueWriteLock uk(getMutex());
 
-					erase(begin() + i);
-					break;
-				}
+				for (size_t i = 0; i < size(); i++)
+					if (at(i).get() == raw_system)
+					{
+						erase(begin() + i);
+						break;
+					}
+			};
+			driver->listen(system.get());
 		};
 
 		/**
@@ -81,16 +81,18 @@ namespace external
 			std::shared_ptr<protocol::ServerConnector> connector(this->createServerConnector());
 			this->communicator_ = connector;
 
-			connector->connect(ip, port);
-
 			// AFTER DISCONNECTION, ERASE THIS OBJECT
-			protocol::SharedEntityDeque<ExternalSystem> *systemArray = (protocol::SharedEntityDeque<ExternalSystem>*)system_array_;
-			for (size_t i = 0; i < systemArray->size(); i++)
-				if (systemArray->at(i).get() == this)
-				{
-					systemArray->erase(systemArray->begin() + i);
-					break;
-				}
+			connector->onClose = [this]()
+			{
+				protocol::SharedEntityDeque<ExternalSystem> *systemArray = (protocol::SharedEntityDeque<ExternalSystem>*)system_array_;
+				for (size_t i = 0; i < systemArray->size(); i++)
+					if (systemArray->at(i).get() == this)
+					{
+						systemArray->erase(systemArray->begin() + i);
+						break;
+					}
+			};
+			connector->connect(ip, port);
 		};
 	};
 };
@@ -3,6 +3,8 @@
 
 #include <samchon/templates/external/ExternalSystem.hpp>
 #include <samchon/protocol/IListener.hpp>
+#include <samchon/protocol/ListenerRegistry.hpp>
+#include <samchon/protocol/Metrics.hpp>
 
 #include <samchon/templates/parallel/base/ParallelSystemArrayBase.hpp>
 
@@ -50,6 +52,10 @@ namespace parallel
 	 * to which {@link ExternalSystem system}. Just access to a role directly from {@link ExternalSystemArray.getRole}.
 	 * Sends and receives {@link Invoke} message via the {@link ExternalSystemRole role}.
 	 *
+	 * #### Metrics
+	 * Parallel processes of the slave are counted by {@link getMetrics Metrics}, which are reported with those of the
+	 * {@link protocol::Communicator communicator} to a {@link protocol::Metrics.QUERY_LISTENER _Metrics} query.
+	 *
 	 * ![Class Diagram](http://samchon.github.io/framework/images/design/cpp_class_diagram/templates_parallel_system.png)
 	 * 
 	 * @handbook [Templates - Parallel System](https://github.com/samchon/framework/wiki/CPP-Templates-Parallel_System)
@@ -69,6 +75,11 @@ namespace parallel
 		bool enforced_{ false };
 		bool excluded_{ false };
 
+		// LISTENERS OF THE INTERNAL INVOKE MESSAGES
+		protocol::ListenerRegistry listeners_{ create_listeners() };
+
+		protocol::Metrics metrics_;
+
 	public:
 		/* ---------------------------------------------------------
 			CONSTRUCTORS
@@ -206,26 +217,52 @@ namespace parallel
 			enforced_ = true;
 		};
 
+		/**
+		 * Get the {@link protocol::Metrics Metrics}.
+		 *
+		 * A {@link ParallelSystem} counts:
+		 *
+		 *	- ```processes.completed```: parallel processes the slave has completed.
+		 *	- ```processes.sent_back```: parallel processes sent back to be shifted to the other slaves.
+		 *	- ```pieces.completed```: pieces of the completed processes.
+		 *	- ```process```: a histogram of nanoseconds the slave has spent for a process.
+		 *
+		 * Processes in progress are {@link _Get_progress_list listed} under the mutex of the {@link ParallelSystemArray}.
+		 */
+		auto getMetrics() -> protocol::Metrics&
+		{
+			return metrics_;
+		};
+
 		/* ---------------------------------------------------------
 			INVOKE MESSAGE CHAIN - PERFORMANCE ESTIMATION
 		--------------------------------------------------------- */
 	protected:
 		virtual void _Reply_data(std::shared_ptr<protocol::Invoke> invoke) override
 		{
-			if (invoke->getListener() == "_Report_history")
-				_Report_history(invoke->front()->getValueAsXML());
-			else if (invoke->getListener() == "_Send_back_history")
+			if (listeners_.dispatch(invoke) == false)
+				replyData(invoke);
+		};
+
+	private:
+		auto create_listeners() -> protocol::ListenerRegistry
+		{
+			protocol::ListenerRegistry listeners;
+			listeners.on<std::shared_ptr<library::XML>>("_Report_history", [this](std::shared_ptr<library::XML> xml)
+			{
+				_Report_history(xml);
+			});
+			listeners.on<size_t>("_Send_back_history", [this](size_t uid)
 			{
-				size_t uid = invoke->front()->getValue<size_t>();
 				auto it = progress_list_.find(uid);
 
 				if (it != progress_list_.end())
 					_Send_back_history(it->second.first, it->second.second);
-			}
-			else
-				replyData(invoke);
+			});
+			return listeners;
 		};
 
+	protected:
 		virtual void _Report_history(std::shared_ptr<library::XML> xml)
 		{
 			//--------
@@ -249,8 +286,18 @@ namespace parallel
 			progress_list_.erase(progress_it);
 			history_list_.insert({ history->getUID(), history });
 
+			metrics_.counter("processes.completed")++;
+			metrics_.counter("pieces.completed") += history->computeSize();
+			metrics_.histogram("process").record(std::chrono::duration_cast<std::chrono::nanoseconds>(history->getEndTime() - history->getStartTime()).count());
+
 			// NOTIFY TO THE MANAGER, SYSTEM_ARRAY
-			((base::ParallelSystemArrayBase*)system_array_)->_Complete_history(history);
+			base::ParallelSystemArrayBase *system_array = (base::ParallelSystemArrayBase*)system_array_;
+			if (system_array->_Complete_history(history) == false)
+				return;
+
+			// RESUME WHO AWAITS THE PARALLEL PROCESS, OUT OF THE LOCK
+			uk.unlock();
+			system_array->_Notify_history(history->getUID());
 		};
 
 		virtual void _Send_back_history(std::shared_ptr<protocol::Invoke> invoke, std::shared_ptr<slave::InvokeHistory> $history)
@@ -277,6 +324,12 @@ namespace parallel
 
 			// ERASE FROM THE PROGRESS LIST
 			progress_list_.erase(history->getUID());
+			metrics_.counter("processes.sent_back")++;
+		};
+
+		virtual auto _Get_metrics() const -> const protocol::Metrics* override
+		{
+			return &metrics_;
 		};
 
 	public:
@@ -5,6 +5,11 @@
 #	include <samchon/templates/parallel/ParallelSystem.hpp>
 #include <samchon/templates/parallel/base/ParallelSystemArrayBase.hpp>
 
+#include <samchon/protocol/InvokePool.hpp>
+#include <samchon/protocol/Coroutine.hpp>
+
+#include <atomic>
+
 namespace samchon
 {
 namespace templates
@@ -183,6 +188,7 @@ namespace parallel
 
 			// TOTAL NUMBER OF PIECES TO DIVIDE
 			size_t segment_size = last - first;
+			protocol::InvokePool &pool = protocol::InvokePool::get();
 
 			// SYSTEMS TO BE GET DIVIDED PROCESSES AND
 			std::vector<std::shared_ptr<ParallelSystem>> system_array;
@@ -212,12 +218,13 @@ namespace parallel
 				if (piece_size == 0)
 					continue;
 
-				std::shared_ptr<protocol::Invoke> my_invoke(new protocol::Invoke(invoke->getListener()));
+				std::shared_ptr<protocol::Invoke> my_invoke = pool.createInvoke(invoke->getListener());
 				{
 					// DUPLICATE INVOKE AND ATTACH PIECE INFO
+					my_invoke->reserve(invoke->size() + 2);
 					my_invoke->assign(invoke->begin(), invoke->end());
-					my_invoke->emplace_back(new protocol::InvokeParameter("_Piece_first", first));
-					my_invoke->emplace_back(new protocol::InvokeParameter("_Piece_last", last));
+					my_invoke->push_back(pool.createParameter("_Piece_first", first));
+					my_invoke->push_back(pool.createParameter("_Piece_last", last));
 				};
 
 				// ENROLL TO PROGRESS LIST
@@ -237,6 +244,79 @@ namespace parallel
 			return threads.size();
 		};
 
+#ifdef SAMCHON_COROUTINE
+		/**
+		 * Send an {@link Invoke} message with segment size, and await completion of the parallel process.
+		 *
+		 * Same with {@link sendSegmentData}, but the coroutine is resumed when all the slave systems have reported
+		 * completion of their pieces, instead of when the pieces have been sent.
+		 *
+		 * @code
+		 * size_t systems = co_await system_array->asyncSegmentData(invoke, 100);
+		 * @endcode
+		 *
+		 * @param invoke An {@link Invoke} message requesting parallel process.
+		 * @param size Number of pieces to segment.
+		 * @return An {@link protocol::Awaitable Awaitable} of number of the slave systems that participated.
+		 */
+		auto asyncSegmentData(std::shared_ptr<protocol::Invoke> invoke, size_t size) -> protocol::Awaitable<size_t>
+		{
+			return asyncPieceData(invoke, 0, size);
+		};
+
+		/**
+		 * Send an {@link Invoke} message with range of pieces, and await completion of the parallel process.
+		 *
+		 * Same with {@link sendPieceData}, but the coroutine is resumed when all the slave systems have reported
+		 * completion of their pieces, from the thread receiving the last report. If no slave system participates, it's
+		 * resumed immediately.
+		 *
+		 * @param invoke An {@link Invoke} message requesting parallel process.
+		 * @param first Initial piece's index in a section.
+		 * @param last Final piece's index in a section.
+		 * @return An {@link protocol::Awaitable Awaitable} of number of the slave systems that participated.
+		 */
+		auto asyncPieceData(std::shared_ptr<protocol::Invoke> invoke, size_t first, size_t last) -> protocol::Awaitable<size_t>
+		{
+			return protocol::Awaitable<size_t>([this, invoke, first, last](protocol::Awaitable<size_t>::Handler handler)
+			{
+				// ASSIGN UID FIRST, TO WAIT FOR IT
+				size_t uid;
+				{
+					std::unique_lock<std::shared_mutex> uk(getMutex());
+
+					if (invoke->has("_History_uid") == false)
+					{
+						uid = _Fetch_history_sequence();
+						invoke->push_back(protocol::InvokePool::get().createParameter("_History_uid", uid));
+					}
+					else
+						uid = invoke->get("_History_uid")->getValue<size_t>();
+				}
+
+				// RESUME AFTER BOTH OF SENDING AND COMPLETION, WHICH MAY COME FIRST
+				struct State
+				{
+					std::atomic<int> arrivals{0};
+					size_t count{0};
+				};
+				std::shared_ptr<State> state(new State());
+				std::function<void()> arrive = [handler, state]()
+				{
+					if (++state->arrivals == 2)
+						handler(state->count, nullptr);
+				};
+				_Wait_history(uid, arrive);
+
+				state->count = sendPieceData(invoke, first, last);
+				if (state->count == 0)
+					_Notify_history(uid); // NOTHING TO WAIT
+
+				arrive();
+			});
+		};
+#endif
+
 		/* ---------------------------------------------------------
 			PERFORMANCE ESTIMATION - INTERNAL METHODS
 		--------------------------------------------------------- */
@@ -3,6 +3,10 @@
 
 #include <samchon/templates/external/base/ExternalSystemArrayBase.hpp>
 
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+
 namespace samchon
 {
 namespace templates
@@ -21,6 +25,10 @@ namespace base
 	private:
 		size_t history_sequence_{0};
 
+		// HANDLERS WAITING FOR COMPLETION OF THE PARALLEL PROCESSES
+		std::mutex waiters_mutex_;
+		std::unordered_map<size_t, std::function<void()>> waiters_;
+
 	public:
 		/* ---------------------------------------------------------
 			CONSTRUCTORS
@@ -55,6 +63,39 @@ namespace base
 		virtual auto sendPieceData(std::shared_ptr<protocol::Invoke> invoke, size_t first, size_t last) -> size_t = 0;
 
 		virtual auto _Complete_history(std::shared_ptr<slave::InvokeHistory> history) -> bool = 0;
+
+		/* ---------------------------------------------------------
+			COMPLETION HANDLERS
+		--------------------------------------------------------- */
+		/**
+		 * Register a handler called when a parallel process has completed.
+		 */
+		void _Wait_history(size_t uid, std::function<void()> handler)
+		{
+			std::unique_lock<std::mutex> uk(waiters_mutex_);
+			waiters_[uid] = std::move(handler);
+		};
+
+		/**
+		 * Call the handler waiting for a parallel process, if exists.
+		 *
+		 * Call it after the {@link _Complete_history} has returned ```true```, out of the system array's lock.
+		 */
+		void _Notify_history(size_t uid)
+		{
+			std::function<void()> handler;
+			{
+				std::unique_lock<std::mutex> uk(waiters_mutex_);
+
+				auto it = waiters_.find(uid);
+				if (it == waiters_.end())
+					return;
+
+				handler = std::move(it->second);
+				waiters_.erase(it);
+			}
+			handler();
+		};
 	};
 };
 };
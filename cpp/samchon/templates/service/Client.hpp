@@ -127,6 +127,18 @@ namespace service
 			return no;
 		};
 
+		/**
+		 * Get driver of the remote client.
+		 *
+		 * Configure its {@link protocol::SendWindow send window} to handle the remote client as a slow consumer.
+		 *
+		 * @return The {@link protocol::WebClientDriver} object.
+		 */
+		auto getDriver() const -> std::shared_ptr<protocol::WebClientDriver>
+		{
+			return driver;
+		};
+
 		/**
 		 * Change related {@link Service} object.
 		 * 
@@ -144,6 +144,14 @@ namespace service
 			std::vector<std::thread> threadArray;
 			std::shared_lock<std::shared_mutex> uk(session_map_mtx);
 
+			// ASYNCHRONOUS MODE, SENDING NEVER WAITS FOR A SLOW CLIENT
+			if (service_pool != nullptr)
+			{
+				for (auto it = session_map.begin(); it != session_map.end(); it++)
+					it->second->sendData(invoke);
+				return;
+			}
+
 			threadArray.reserve(session_map.size());
 			for (auto it = session_map.begin(); it != session_map.end(); it++)
 				threadArray.emplace_back(&User::sendData, it->second.get(), invoke);
@@ -253,12 +261,21 @@ namespace service
 			///////
 			// BEGINS COMMUNICATION
 			///////
-			client->driver->listen(client.get());
-
 			// DISCONNECTED - ERASE CLIENT.
 			// IF THE USER HAS NO CLIENT LEFT, THEN THE USER WILL ALSO BE ERASED.
-			user->erase(client->no);
-			user->check_empty();
+			std::weak_ptr<User> user_weak_ptr = user;
+			size_t no = client->no;
+
+			client->driver->onClose = [user_weak_ptr, no]()
+			{
+				std::shared_ptr<User> user = user_weak_ptr.lock();
+				if (user == nullptr)
+					return;
+
+				user->erase(no);
+				user->check_empty();
+			};
+			client->driver->listen(client.get());
 		};
 
 		void erase_user(User *user)
@@ -233,7 +233,10 @@ namespace service
 
 			threadArray.reserve(size());
 			for (auto it = begin(); it != end(); it++)
-				threadArray.emplace_back(&Client::sendData, it->second.get(), invoke);
+				if (it->second->getDriver()->isAsynchronous() == true)
+					it->second->sendData(invoke); // ENQUEUED ONLY, NEVER WAITS FOR THE CLIENT
+				else
+					threadArray.emplace_back(&Client::sendData, it->second.get(), invoke);
 
 			uk.unlock();
 			for (auto it = threadArray.begin(); it != threadArray.end(); it++)
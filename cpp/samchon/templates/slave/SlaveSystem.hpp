@@ -4,6 +4,8 @@
 #include <samchon/protocol/IListener.hpp>
 
 #include <samchon/protocol/Communicator.hpp>
+#include <samchon/protocol/Coroutine.hpp>
+#include <samchon/protocol/Metrics.hpp>
 #include <samchon/templates/slave/PInvoke.hpp>
 
 namespace samchon
@@ -18,6 +20,9 @@ namespace slave
 	protected:
 		std::shared_ptr<protocol::Communicator> communicator_;
 
+	private:
+		protocol::Metrics metrics_;
+
 	public:
 		/* ---------------------------------------------------------
 			CONSTRUCTORS
@@ -34,32 +39,106 @@ namespace slave
 		{
 			communicator_->sendData(invoke);
 		};
+
+		/**
+		 * Get the {@link protocol::Metrics Metrics}.
+		 *
+		 * A {@link SlaveSystem} counts:
+		 *
+		 *	- ```processes.received```: processes requested by the master.
+		 *	- ```processes.completed```: processes completed by the handler.
+		 *	- ```processes.held```: processes {@link PInvoke.hold held} by the handler, to be completed later.
+		 *	- ```process```: a histogram of nanoseconds spent for a process completed by the handler.
+		 *
+		 * They are reported with those of the {@link protocol::Communicator communicator} to a
+		 * {@link protocol::Metrics.QUERY_LISTENER _Metrics} query of the master.
+		 */
+		auto getMetrics() -> protocol::Metrics&
+		{
+			return metrics_;
+		};
 		
 	protected:
 		virtual void _Reply_data(std::shared_ptr<protocol::Invoke> invoke) override
 		{
 			if (invoke->has("_History_uid"))
 			{
-				std::thread([this, invoke]()
+				// INIT HISTORY - WITH START TIME
+				std::shared_ptr<InvokeHistory> history(new InvokeHistory(invoke));
+				invoke->erase("_History_uid");
+				invoke->erase("_Process_name");
+				invoke->erase("_Process_weight");
+
+				std::shared_ptr<PInvoke> pInvoke(new PInvoke(invoke, history, this));
+				metrics_.counter("processes.received")++;
+
+#ifdef SAMCHON_COROUTINE
+				// MAIN PROCESS BY A COROUTINE, WITHOUT A THREAD
+				protocol::Task task = replyTask(pInvoke);
+				if (task.valid() == true)
 				{
-					// INIT HISTORY - WITH START TIME
-					std::shared_ptr<InvokeHistory> history(new InvokeHistory(invoke));
-					invoke->erase("_History_uid");
-					invoke->erase("_Process_name");
-					invoke->erase("_Process_weight");
+					task.start([this, pInvoke]()
+					{
+						// NOTIFY - WITH END TIME
+						complete_process(pInvoke);
+					});
+					return;
+				}
+#endif
 
+				std::thread([this, pInvoke]()
+				{
 					// MAIN PROCESS - REPLY_DATA
-					std::shared_ptr<PInvoke> pInvoke(new PInvoke(invoke, history, this));
 					replyData(pInvoke);
 
 					// NOTIFY - WITH END TIME
-					if (pInvoke->isHold() == false)
-						pInvoke->complete();
+					complete_process(pInvoke);
 				}).detach();
 			}
 			else
 				replyData(invoke);
 		};
+
+		virtual auto _Get_metrics() const -> const protocol::Metrics* override
+		{
+			return &metrics_;
+		};
+
+#ifdef SAMCHON_COROUTINE
+		/**
+		 * Handle a requested process by a coroutine.
+		 *
+		 * A process requested by the master is handled by {@link replyData replyData()} in a thread of its own. Override
+		 * this method to handle it by a coroutine instead, which awaits I/O by ```co_await``` without occupying a
+		 * thread. The coroutine starts in the thread receiving the request, so don't block in it.
+		 *
+		 * The process is reported as completed when the coroutine has finished, unless the *invoke* is
+		 * {@link PInvoke.hold held}.
+		 *
+		 * @param invoke The requested process.
+		 * @return A coroutine handling the *invoke*. An empty {@link protocol::Task Task}, the default, hands the
+		 *		   *invoke* over to {@link replyData replyData()} in a thread.
+		 */
+		virtual auto replyTask(std::shared_ptr<PInvoke> invoke) -> protocol::Task
+		{
+			return protocol::Task();
+		};
+#endif
+
+	private:
+		void complete_process(std::shared_ptr<PInvoke> invoke)
+		{
+			if (invoke->isHold() == true)
+			{
+				metrics_.counter("processes.held")++;
+				return;
+			}
+			invoke->complete();
+
+			std::shared_ptr<InvokeHistory> history = invoke->getHistory();
+			metrics_.counter("processes.completed")++;
+			metrics_.histogram("process").record(std::chrono::duration_cast<std::chrono::nanoseconds>(history->getEndTime() - history->getStartTime()).count());
+		};
 	};
 };
 };